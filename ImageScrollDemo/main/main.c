@@ -268,104 +268,29 @@ void app_main(void)
 
 	int numOfTable = sizeof(imageTable)/sizeof(int);
 	ESP_LOGI(TAG, "numOfTable=%d", numOfTable);
-	// Allocate memory
-	uint8_t *buffer = (uint8_t *)malloc(8*128); // 8 page 128 pixel
-	if (buffer == NULL) {
+
+	// Canvas of all characters with one blank screen before and after them
+	int canvasWidth = 128 + numOfTable*IMAGE_WIDTH + 128;
+	uint8_t *canvasBuffer = (uint8_t *)malloc(8*canvasWidth); // 8 page canvasWidth pixel
+	if (canvasBuffer == NULL) {
 		ESP_LOGE(TAG, "malloc failed");
 		while(1) { vTaskDelay(1); }
 	}
-	uint8_t *segmentImage = (uint8_t *)malloc(NUM_IMAGES*8*IMAGE_WIDTH); // 10 image 8 page 48 pixel
-	if (segmentImage == NULL) {
-		ESP_LOGE(TAG, "malloc failed");
-		while(1) { vTaskDelay(1); }
+	ssd1306_canvas_t canvas;
+	ssd1306_canvas_init(&canvas, canvasBuffer, canvasWidth, 64);
+	ssd1306_canvas_clear(&canvas, false);
+	for (int imageIndex=0;imageIndex<numOfTable;imageIndex++) {
+		if (imageTable[imageIndex] < 0) continue;
+		ssd1306_canvas_bitmaps(&canvas, 128+imageIndex*IMAGE_WIDTH, 1, segmentDisplay[imageTable[imageIndex]], IMAGE_WIDTH, 62, false);
 	}
 
-	// Convert from segmentDisplay to segmentImage
-	for (int imageIndex=0;imageIndex<NUM_IMAGES;imageIndex++) {
-		ssd1306_clear_screen(&dev, false);
-		ssd1306_bitmaps(&dev, 0, 1, segmentDisplay[imageIndex], IMAGE_WIDTH, 62, false);
-		vTaskDelay(200 / portTICK_PERIOD_MS);
-
-		// Get from internal buffer to local buffer
-		// buffer is [8][128] 8 page 128 pixel
-		ssd1306_get_buffer(&dev, buffer);
-
-		// Save from buffer to segmentImage
-		// segmentImage is [10][8][IMAGE_WIDTH] 10 image 8 page 48 pixel
-		int segmentImageIndex = imageIndex * BITMAPS;
-		for (int page=0;page<8;page++) {
-			//ESP_LOGI(TAG, "segmentImageIndex+page*IMAGE_WIDTH=%d", segmentImageIndex+page*IMAGE_WIDTH);
-			memcpy(&segmentImage[segmentImageIndex+page*IMAGE_WIDTH], &buffer[page*128], IMAGE_WIDTH);
-			//ESP_LOGI(TAG, "page=%d", page);
-			//ESP_LOG_BUFFER_HEXDUMP(TAG, &buffer[page*128], IMAGE_WIDTH, ESP_LOG_INFO);
-		}
-
-#if 0
-		ssd1306_clear_screen(&dev, false);
-		for (int page=0;page<8;page++) {
-			ssd1306_display_image(&dev, page, 0, &segmentImage[segmentImageIndex+page*IMAGE_WIDTH], IMAGE_WIDTH);
-			//ESP_LOGI(TAG, "page=%d", page);
-			//ESP_LOG_BUFFER_HEXDUMP(TAG, &segmentImage[segmentImageIndex+page*IMAGE_WIDTH], IMAGE_WIDTH, ESP_LOG_INFO);
-		}
-		vTaskDelay(1000 / portTICK_PERIOD_MS);
-#endif
-	}
-
-	int imageIndex = 0;
-	int imageSegment = 0;
-	ssd1306_clear_screen(&dev, false);
-
 	while(1) {
-
-		// Shift segment data left by 2 bits
-		for (int page=0;page<8;page++) {
-			int bufferIndex = page*128;
-			memcpy(&buffer[bufferIndex], &buffer[bufferIndex+2], 126);
-		}
-
-		// Insert 2 bits at the end of segment data
-		if (imageTable[imageIndex] >= 0) {
-			int segmentImageIndex = imageTable[imageIndex] * BITMAPS;
-			for (int page=0;page<8;page++) {
-				int bufferIndex = page*128+126;
-				buffer[bufferIndex] = segmentImage[segmentImageIndex+page*IMAGE_WIDTH+imageSegment];
-				buffer[bufferIndex+1] = segmentImage[segmentImageIndex+page*IMAGE_WIDTH+imageSegment+1];
-			}
-		} else {
-			for (int page=0;page<8;page++) {
-				int bufferIndex = page*128+126;
-				buffer[bufferIndex] = 0;
-				buffer[bufferIndex+1] = 0;
-			}
-		}
-		imageSegment=imageSegment+2;	
-		ssd1306_set_buffer(&dev, buffer);
-		ssd1306_show_buffer(&dev);
-		//vTaskDelay(5);
-
-		// End of display of one character
-		if (imageSegment == IMAGE_WIDTH) {
-			imageIndex++;
-			if (imageIndex == numOfTable) {
-				// All characters have been displayed.
-				// Scroll to last character.
-				for (int segs=0;segs<64;segs++) {
-					for (int page=0;page<8;page++) {
-						int bufferIndex = page*128;
-						memcpy(&buffer[bufferIndex], &buffer[bufferIndex+2], 126);
-					}
-					for (int page=0;page<8;page++) {
-						int bufferIndex = page*128+126;
-						buffer[bufferIndex]=0;
-						buffer[bufferIndex+1]=0;
-					}
-					ssd1306_set_buffer(&dev, buffer);
-					ssd1306_show_buffer(&dev);
-				}
-				imageIndex = 0;
-			}
-			imageSegment = 0;
+		// Move the viewport 2 pixels at a time. Nothing is copied.
+		for (int xpos=0;xpos<=canvasWidth-128;xpos=xpos+2) {
+			ssd1306_canvas_pan(&canvas, xpos, 0);
+			ssd1306_canvas_show(&dev, &canvas);
 		}
+		vTaskDelay(1);
 	} // end while
-	free(buffer);
+	free(canvasBuffer);
 }
@@ -102,6 +102,17 @@ static uint8_t VUMeter1[1024] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 
+// Frames handed over from the drawing loop to the sending task
+static ssd1306_swap_t swap;
+
+// Send the latest frame while app_main draws the next one
+void flush_task(void *pvParameters)
+{
+	while(1) {
+		if (ssd1306_swap_flush(&swap) == false) vTaskDelay(1);
+	}
+}
+
 void app_main(void)
 {
 #if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
@@ -178,6 +189,10 @@ void app_main(void)
 	// Get from internal buffer to local buffer
 	ssd1306_get_buffer(&dev, buffer);
 
+	// 3 frames. A slow bus never stops the drawing loop
+	ssd1306_swap_init(&dev, &swap, SSD1306_SWAP_LATEST);
+	xTaskCreate(flush_task, "FLUSH", 1024*2, NULL, 2, NULL);
+
 	int hMeter = 65; // horizontal center for needle animation
 	//int vMeter = 85; // vertical center for needle animation (outside of dislay limits)
 	int vMeter = 63; // vertical center for needle animation (outside of dislay limits)
@@ -211,8 +226,8 @@ void app_main(void)
 		// Set needle
 		_ssd1306_line(&dev, a1, a2, hMeter, vMeter, false);
 
-		// Display the entire image
-		ssd1306_show_buffer(&dev);
+		// Hand the entire image to flush_task
+		ssd1306_swap_present(&swap);
 		vTaskDelay(1);
 
 		// Erase needle
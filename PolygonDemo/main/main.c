@@ -0,0 +1,209 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "ssd1306.h"
+
+/*
+ You have to set this config value with menuconfig
+ CONFIG_INTERFACE
+
+ for i2c
+ CONFIG_MODEL
+ CONFIG_SDA_GPIO
+ CONFIG_SCL_GPIO
+ CONFIG_RESET_GPIO
+
+ for SPI
+ CONFIG_CS_GPIO
+ CONFIG_DC_GPIO
+ CONFIG_RESET_GPIO
+*/
+
+#define TAG "SSD1306"
+
+#define LOOPS 1000
+
+typedef enum {
+	SHAPE_TRIANGLE = 0,
+	SHAPE_ARROW,
+	SHAPE_STAR,
+	SHAPE_CIRCLE,
+	SHAPE_ROUND_RECT,
+	SHAPE_MAX
+} shape_t;
+
+static const char * shape_name[SHAPE_MAX] = {
+	"triangle 64x32",
+	"arrow 7 points",
+	"star 5 points",
+	"circle r=16",
+	"round rect 48x24",
+};
+
+static const ssd1306_point_t arrow[7] = {
+	{0, 8}, {20, 8}, {20, 0}, {36, 14}, {20, 28}, {20, 20}, {0, 20}
+};
+
+static const ssd1306_point_t star[5] = {
+	{18, 0}, {30, 36}, {0, 14}, {36, 14}, {6, 36}
+};
+
+static void draw_shape(SSD1306_t * dev, shape_t shape, int x, int y)
+{
+	ssd1306_point_t points[7];
+	switch (shape) {
+	case SHAPE_TRIANGLE:
+		ssd1306_fill_triangle(dev, x, y, x+63, y+10, x+20, y+31, false);
+		break;
+	case SHAPE_ARROW:
+		for (int i=0;i<7;i++) {
+			points[i].x = arrow[i].x + x;
+			points[i].y = arrow[i].y + y;
+		}
+		ssd1306_fill_polygon(dev, points, 7, false);
+		break;
+	case SHAPE_STAR:
+		for (int i=0;i<5;i++) {
+			points[i].x = star[i].x + x;
+			points[i].y = star[i].y + y;
+		}
+		ssd1306_fill_polygon(dev, points, 5, false);
+		break;
+	case SHAPE_CIRCLE:
+		ssd1306_fill_circle(dev, x+16, y+16, 16, false);
+		break;
+	case SHAPE_ROUND_RECT:
+		ssd1306_fill_round_rect(dev, x, y, 48, 24, 6, false);
+		break;
+	default:
+		break;
+	}
+}
+
+#define FRAMES 500
+
+static ssd1306_pipeline_t pipe;
+static TaskHandle_t mainTask;
+
+// Draw a bouncing star into internal buffer and queue each frame for the flush task.
+void render_task(void *pvParameters)
+{
+	SSD1306_t * dev = (SSD1306_t *)pvParameters;
+	int width = ssd1306_get_width(dev);
+	int height = ssd1306_get_height(dev);
+	int x = 0, y = 0, dx = 3, dy = 1;
+	for (int frame=0; frame<FRAMES; frame++) {
+		ssd1306_pipeline_begin(&pipe);
+		ssd1306_fill_rect(dev, 0, 0, width, height, true);
+		draw_shape(dev, SHAPE_STAR, x, y);
+		ssd1306_pipeline_submit(&pipe, true);
+		x = x + dx;
+		y = y + dy;
+		if (x < 0 || x > width - 32) dx = -dx;
+		if (y < 0 || y > height - 32) dy = -dy;
+	}
+	xTaskNotifyGive(mainTask);
+	vTaskDelete(NULL);
+}
+
+void app_main(void)
+{
+	SSD1306_t dev;
+
+#if CONFIG_I2C_INTERFACE
+	ESP_LOGI(TAG, "INTERFACE is i2c");
+	ESP_LOGI(TAG, "CONFIG_SDA_GPIO=%d",CONFIG_SDA_GPIO);
+	ESP_LOGI(TAG, "CONFIG_SCL_GPIO=%d",CONFIG_SCL_GPIO);
+	ESP_LOGI(TAG, "CONFIG_RESET_GPIO=%d",CONFIG_RESET_GPIO);
+	i2c_master_init(&dev, CONFIG_SDA_GPIO, CONFIG_SCL_GPIO, CONFIG_RESET_GPIO);
+#endif // CONFIG_I2C_INTERFACE
+
+#if CONFIG_SPI_INTERFACE
+	ESP_LOGI(TAG, "INTERFACE is SPI");
+	ESP_LOGI(TAG, "CONFIG_MOSI_GPIO=%d",CONFIG_MOSI_GPIO);
+	ESP_LOGI(TAG, "CONFIG_SCLK_GPIO=%d",CONFIG_SCLK_GPIO);
+	ESP_LOGI(TAG, "CONFIG_CS_GPIO=%d",CONFIG_CS_GPIO);
+	ESP_LOGI(TAG, "CONFIG_DC_GPIO=%d",CONFIG_DC_GPIO);
+	ESP_LOGI(TAG, "CONFIG_RESET_GPIO=%d",CONFIG_RESET_GPIO);
+	spi_master_init(&dev, CONFIG_MOSI_GPIO, CONFIG_SCLK_GPIO, CONFIG_CS_GPIO, CONFIG_DC_GPIO, CONFIG_RESET_GPIO);
+#endif // CONFIG_SPI_INTERFACE
+
+#if CONFIG_FLIP
+	dev._flip = true;
+	ESP_LOGW(TAG, "Flip upside down");
+#endif
+
+#if CONFIG_SSD1306_128x64
+	ESP_LOGI(TAG, "Panel is 128x64");
+	ssd1306_init(&dev, 128, 64);
+#endif // CONFIG_SSD1306_128x64
+#if CONFIG_SSD1306_128x32
+	ESP_LOGI(TAG, "Panel is 128x32");
+	ssd1306_init(&dev, 128, 32);
+#endif // CONFIG_SSD1306_128x32
+
+	ssd1306_contrast(&dev, 0xff);
+	ssd1306_clear_screen(&dev, false);
+
+	int width = ssd1306_get_width(&dev);
+	int height = ssd1306_get_height(&dev);
+	int rate[SHAPE_MAX];
+
+	for (int shape=0; shape<SHAPE_MAX; shape++) {
+		// Draw at various position including partly outside of the panel
+		int64_t start = esp_timer_get_time();
+		for (int loop=0; loop<LOOPS; loop++) {
+			int x = (loop * 37) % width - 16;
+			int y = (loop * 13) % height - 8;
+			draw_shape(&dev, shape, x, y);
+		}
+		int64_t elapsed = esp_timer_get_time() - start;
+		rate[shape] = (int)((int64_t)LOOPS * 1000000 / elapsed);
+		ESP_LOGI(TAG, "%-22s : %d shapes/sec", shape_name[shape], rate[shape]);
+
+		// Show the last frame of this shape
+		ssd1306_clear_screen(&dev, false);
+		draw_shape(&dev, shape, 16, 0);
+		ssd1306_show_dirty(&dev);
+		vTaskDelay(2000 / portTICK_PERIOD_MS);
+		ssd1306_clear_screen(&dev, false);
+		vTaskDelay(1);
+	}
+
+	// Render on the last core and send on core 0, where app_main initialized the bus and its interrupt.
+	// Single core chips run both on core 0.
+	ssd1306_pipeline_start(&dev, &pipe, 0, 5);
+	mainTask = xTaskGetCurrentTaskHandle();
+	xTaskCreatePinnedToCore(render_task, "RENDER", 1024*4, &dev, 2, NULL, portNUM_PROCESSORS - 1);
+	ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+	ssd1306_pipeline_stats_t stats;
+	ssd1306_pipeline_stats(&pipe, &stats);
+	ssd1306_pipeline_stop(&pipe);
+	ESP_LOGI(TAG, "pipeline frames=%"PRIu32" pages=%"PRIu32, stats.frames, stats.pages);
+	ESP_LOGI(TAG, "render=%"PRId64"us submit=%"PRId64"us flush=%"PRId64"us idle=%"PRId64"us",
+		stats.renderTime, stats.submitTime, stats.flushTime, stats.idleTime);
+	// Waiting for a free slot means the bus is slower than drawing
+	if (stats.submitTime > stats.renderTime) {
+		ESP_LOGI(TAG, "pipeline is bus-bound");
+	} else {
+		ESP_LOGI(TAG, "pipeline is render-bound");
+	}
+	ssd1306_clear_screen(&dev, false);
+
+	// Show the results
+	char lineChar[20];
+	for (int shape=0; shape<SHAPE_MAX && shape<ssd1306_get_pages(&dev); shape++) {
+		int lineLen = sprintf(lineChar, "%-9.9s%7d", shape_name[shape], rate[shape]);
+		ssd1306_display_text(&dev, shape, lineChar, lineLen, false);
+	}
+
+	while(1) {
+		vTaskDelay(1000 / portTICK_PERIOD_MS);
+	}
+}
@@ -177,7 +177,48 @@ void app_main(void)
 	ssd1306_hardware_scroll(&dev, SCROLL_UP);
 	vTaskDelay(5000 / portTICK_PERIOD_MS);
 	ssd1306_hardware_scroll(&dev, SCROLL_STOP);
-	
+
+	// Ticker
+	ssd1306_clear_screen(&dev, false);
+	ssd1306_display_text(&dev, 0, "     Ticker", 11, false);
+	ssd1306_ticker_t ticker;
+	char message[] = "Long status messages scroll through the ticker band. ";
+	ssd1306_ticker_init(&dev, &ticker, NULL, center, 0, 127, message, strlen(message), 32, true, false);
+	for (int i=0;i<200;i++) {
+		ssd1306_ticker_tick(&ticker, 2);
+		vTaskDelay(2);
+	}
+
+	// Display List
+	// The box is recorded once. Moving it replays the commands without text layout.
+	ssd1306_clear_screen(&dev, false);
+	static uint8_t listBuffer[512];
+	ssd1306_list_t list;
+	ssd1306_list_init(&list, listBuffer, sizeof(listBuffer));
+	ssd1306_list_fill_rect(&list, 0, 0, 64, 24, false);
+	ssd1306_list_fill_rect(&list, 1, 1, 62, 22, true);
+	ssd1306_list_text(&list, 4, 3, "Display", 7, false, DRAW_OR);
+	ssd1306_list_text(&list, 4, 12, "List", 4, false, DRAW_OR);
+	ssd1306_list_line(&list, 40, 20, 60, 12, false);
+	int ypos = (ssd1306_get_height(&dev) - 24) / 2;
+	for (int xpos=0;xpos<=64;xpos++) {
+		ssd1306_fill_rect(&dev, xpos-1, ypos, 1, 24, true);
+		ssd1306_list_replay(&dev, &list, xpos, ypos);
+		ssd1306_show_dirty(&dev);
+		vTaskDelay(2);
+	}
+	vTaskDelay(2000 / portTICK_PERIOD_MS);
+
+#if CONFIG_SSD1306_128x64
+	// Hardware Zoom
+	ssd1306_clear_screen(&dev, false);
+	ssd1306_hardware_zoom(&dev, 0);
+	ssd1306_display_text_zoom(&dev, 0, "Zoom", 4, 2, false);
+	ssd1306_display_text_zoom(&dev, 2, "x2 x2", 5, 2, true);
+	vTaskDelay(5000 / portTICK_PERIOD_MS);
+	ssd1306_hardware_zoom(&dev, -1);
+#endif // CONFIG_SSD1306_128x64
+
 	// Invert
 	ssd1306_clear_screen(&dev, true);
 	ssd1306_contrast(&dev, 0xff);
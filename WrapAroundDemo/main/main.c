@@ -103,6 +103,13 @@ void app_main(void)
 		}
 		vTaskDelay(2000 / portTICK_PERIOD_MS);
 
+		// Only the center 64 segments of page 1 and 2, 4 pixels at a time
+		for(int i=0;i<64/4;i++) {
+			ssd1306_wrap_arround_window(&dev, SCROLL_LEFT, 1, 2, 32, 95, 4, 0);
+			vTaskDelay(1);
+		}
+		vTaskDelay(2000 / portTICK_PERIOD_MS);
+
 		int height = ssd1306_get_height(&dev);
 		ESP_LOGD(TAG, "height=%d", height);
 		for(int i=0;i<height;i++) {
@@ -0,0 +1,235 @@
+/*
+ * font5x7.h
+ *
+ * Generated by tools/bdf2font.py from font5x7.bdf
+ * Regenerate with: python3 tools/bdf2font.py tools/font5x7.bdf --name font5x7 --proportional --spacing 1 --kerning tools/font5x7_kerning.txt
+ * height=8 ascent=7 characters=95 ranges=1 bitmap=419 bytes
+ */
+
+#ifndef MAIN_FONT5X7_H_
+#define MAIN_FONT5X7_H_
+
+#include "ssd1306.h"
+
+static const uint8_t font5x7_bitmap[419] = {
+    0x5F,   // U+0021 !
+    0x07, 0x00, 0x07,   // U+0022 "
+    0x14, 0x7F, 0x14, 0x7F, 0x14,   // U+0023 #
+    0x24, 0x2A, 0x7F, 0x2A, 0x12,   // U+0024 $
+    0x23, 0x13, 0x08, 0x64, 0x62,   // U+0025 %
+    0x36, 0x49, 0x55, 0x22, 0x50,   // U+0026 &
+    0x05, 0x03,   // U+0027 '
+    0x1C, 0x22, 0x41,   // U+0028 (
+    0x41, 0x22, 0x1C,   // U+0029 )
+    0x08, 0x2A, 0x1C, 0x2A, 0x08,   // U+002A *
+    0x08, 0x08, 0x3E, 0x08, 0x08,   // U+002B +
+    0x50, 0x30,   // U+002C ,
+    0x08, 0x08, 0x08, 0x08, 0x08,   // U+002D -
+    0x60, 0x60,   // U+002E .
+    0x20, 0x10, 0x08, 0x04, 0x02,   // U+002F /
+    0x3E, 0x51, 0x49, 0x45, 0x3E,   // U+0030 0
+    0x42, 0x7F, 0x40,   // U+0031 1
+    0x42, 0x61, 0x51, 0x49, 0x46,   // U+0032 2
+    0x21, 0x41, 0x45, 0x4B, 0x31,   // U+0033 3
+    0x18, 0x14, 0x12, 0x7F, 0x10,   // U+0034 4
+    0x27, 0x45, 0x45, 0x45, 0x39,   // U+0035 5
+    0x3C, 0x4A, 0x49, 0x49, 0x30,   // U+0036 6
+    0x01, 0x71, 0x09, 0x05, 0x03,   // U+0037 7
+    0x36, 0x49, 0x49, 0x49, 0x36,   // U+0038 8
+    0x06, 0x49, 0x49, 0x29, 0x1E,   // U+0039 9
+    0x36, 0x36,   // U+003A :
+    0x56, 0x36,   // U+003B ;
+    0x08, 0x14, 0x22, 0x41,   // U+003C <
+    0x14, 0x14, 0x14, 0x14, 0x14,   // U+003D =
+    0x41, 0x22, 0x14, 0x08,   // U+003E >
+    0x02, 0x01, 0x51, 0x09, 0x06,   // U+003F ?
+    0x32, 0x49, 0x79, 0x41, 0x3E,   // U+0040 @
+    0x7E, 0x11, 0x11, 0x11, 0x7E,   // U+0041 A
+    0x7F, 0x49, 0x49, 0x49, 0x36,   // U+0042 B
+    0x3E, 0x41, 0x41, 0x41, 0x22,   // U+0043 C
+    0x7F, 0x41, 0x41, 0x22, 0x1C,   // U+0044 D
+    0x7F, 0x49, 0x49, 0x49, 0x41,   // U+0045 E
+    0x7F, 0x09, 0x09, 0x01, 0x01,   // U+0046 F
+    0x3E, 0x41, 0x41, 0x51, 0x32,   // U+0047 G
+    0x7F, 0x08, 0x08, 0x08, 0x7F,   // U+0048 H
+    0x41, 0x7F, 0x41,   // U+0049 I
+    0x20, 0x40, 0x41, 0x3F, 0x01,   // U+004A J
+    0x7F, 0x08, 0x14, 0x22, 0x41,   // U+004B K
+    0x7F, 0x40, 0x40, 0x40, 0x40,   // U+004C L
+    0x7F, 0x02, 0x04, 0x02, 0x7F,   // U+004D M
+    0x7F, 0x04, 0x08, 0x10, 0x7F,   // U+004E N
+    0x3E, 0x41, 0x41, 0x41, 0x3E,   // U+004F O
+    0x7F, 0x09, 0x09, 0x09, 0x06,   // U+0050 P
+    0x3E, 0x41, 0x51, 0x21, 0x5E,   // U+0051 Q
+    0x7F, 0x09, 0x19, 0x29, 0x46,   // U+0052 R
+    0x46, 0x49, 0x49, 0x49, 0x31,   // U+0053 S
+    0x01, 0x01, 0x7F, 0x01, 0x01,   // U+0054 T
+    0x3F, 0x40, 0x40, 0x40, 0x3F,   // U+0055 U
+    0x1F, 0x20, 0x40, 0x20, 0x1F,   // U+0056 V
+    0x7F, 0x20, 0x18, 0x20, 0x7F,   // U+0057 W
+    0x63, 0x14, 0x08, 0x14, 0x63,   // U+0058 X
+    0x03, 0x04, 0x78, 0x04, 0x03,   // U+0059 Y
+    0x61, 0x51, 0x49, 0x45, 0x43,   // U+005A Z
+    0x7F, 0x41, 0x41,   // U+005B [
+    0x02, 0x04, 0x08, 0x10, 0x20,   // U+005C 
+    0x41, 0x41, 0x7F,   // U+005D ]
+    0x04, 0x02, 0x01, 0x02, 0x04,   // U+005E ^
+    0x40, 0x40, 0x40, 0x40, 0x40,   // U+005F _
+    0x01, 0x02, 0x04,   // U+0060 `
+    0x20, 0x54, 0x54, 0x54, 0x78,   // U+0061 a
+    0x7F, 0x48, 0x44, 0x44, 0x38,   // U+0062 b
+    0x38, 0x44, 0x44, 0x44, 0x20,   // U+0063 c
+    0x38, 0x44, 0x44, 0x48, 0x7F,   // U+0064 d
+    0x38, 0x54, 0x54, 0x54, 0x18,   // U+0065 e
+    0x08, 0x7E, 0x09, 0x01, 0x02,   // U+0066 f
+    0x08, 0x14, 0x54, 0x54, 0x3C,   // U+0067 g
+    0x7F, 0x08, 0x04, 0x04, 0x78,   // U+0068 h
+    0x44, 0x7D, 0x40,   // U+0069 i
+    0x20, 0x40, 0x44, 0x3D,   // U+006A j
+    0x7F, 0x10, 0x28, 0x44,   // U+006B k
+    0x41, 0x7F, 0x40,   // U+006C l
+    0x7C, 0x04, 0x18, 0x04, 0x78,   // U+006D m
+    0x7C, 0x08, 0x04, 0x04, 0x78,   // U+006E n
+    0x38, 0x44, 0x44, 0x44, 0x38,   // U+006F o
+    0x7C, 0x14, 0x14, 0x14, 0x08,   // U+0070 p
+    0x08, 0x14, 0x14, 0x18, 0x7C,   // U+0071 q
+    0x7C, 0x08, 0x04, 0x04, 0x08,   // U+0072 r
+    0x48, 0x54, 0x54, 0x54, 0x20,   // U+0073 s
+    0x04, 0x3F, 0x44, 0x40, 0x20,   // U+0074 t
+    0x3C, 0x40, 0x40, 0x20, 0x7C,   // U+0075 u
+    0x1C, 0x20, 0x40, 0x20, 0x1C,   // U+0076 v
+    0x3C, 0x40, 0x30, 0x40, 0x3C,   // U+0077 w
+    0x44, 0x28, 0x10, 0x28, 0x44,   // U+0078 x
+    0x0C, 0x50, 0x50, 0x50, 0x3C,   // U+0079 y
+    0x44, 0x64, 0x54, 0x4C, 0x44,   // U+007A z
+    0x08, 0x36, 0x41,   // U+007B {
+    0x7F,   // U+007C |
+    0x41, 0x36, 0x08,   // U+007D }
+    0x02, 0x01, 0x02, 0x04, 0x02,   // U+007E ~
+};
+
+static const ssd1306_glyph_t font5x7_glyphs[95] = {
+    {     0,  0,  4,  0 },   // U+0020
+    {     0,  1,  2,  0 },   // U+0021
+    {     1,  3,  4,  0 },   // U+0022
+    {     4,  5,  6,  0 },   // U+0023
+    {     9,  5,  6,  0 },   // U+0024
+    {    14,  5,  6,  0 },   // U+0025
+    {    19,  5,  6,  0 },   // U+0026
+    {    24,  2,  3,  0 },   // U+0027
+    {    26,  3,  4,  0 },   // U+0028
+    {    29,  3,  4,  0 },   // U+0029
+    {    32,  5,  6,  0 },   // U+002A
+    {    37,  5,  6,  0 },   // U+002B
+    {    42,  2,  3,  0 },   // U+002C
+    {    44,  5,  6,  0 },   // U+002D
+    {    49,  2,  3,  0 },   // U+002E
+    {    51,  5,  6,  0 },   // U+002F
+    {    56,  5,  6,  0 },   // U+0030
+    {    61,  3,  4,  0 },   // U+0031
+    {    64,  5,  6,  0 },   // U+0032
+    {    69,  5,  6,  0 },   // U+0033
+    {    74,  5,  6,  0 },   // U+0034
+    {    79,  5,  6,  0 },   // U+0035
+    {    84,  5,  6,  0 },   // U+0036
+    {    89,  5,  6,  0 },   // U+0037
+    {    94,  5,  6,  0 },   // U+0038
+    {    99,  5,  6,  0 },   // U+0039
+    {   104,  2,  3,  0 },   // U+003A
+    {   106,  2,  3,  0 },   // U+003B
+    {   108,  4,  5,  0 },   // U+003C
+    {   112,  5,  6,  0 },   // U+003D
+    {   117,  4,  5,  0 },   // U+003E
+    {   121,  5,  6,  0 },   // U+003F
+    {   126,  5,  6,  0 },   // U+0040
+    {   131,  5,  6,  0 },   // U+0041
+    {   136,  5,  6,  0 },   // U+0042
+    {   141,  5,  6,  0 },   // U+0043
+    {   146,  5,  6,  0 },   // U+0044
+    {   151,  5,  6,  0 },   // U+0045
+    {   156,  5,  6,  0 },   // U+0046
+    {   161,  5,  6,  0 },   // U+0047
+    {   166,  5,  6,  0 },   // U+0048
+    {   171,  3,  4,  0 },   // U+0049
+    {   174,  5,  6,  0 },   // U+004A
+    {   179,  5,  6,  0 },   // U+004B
+    {   184,  5,  6,  0 },   // U+004C
+    {   189,  5,  6,  0 },   // U+004D
+    {   194,  5,  6,  0 },   // U+004E
+    {   199,  5,  6,  0 },   // U+004F
+    {   204,  5,  6,  0 },   // U+0050
+    {   209,  5,  6,  0 },   // U+0051
+    {   214,  5,  6,  0 },   // U+0052
+    {   219,  5,  6,  0 },   // U+0053
+    {   224,  5,  6,  0 },   // U+0054
+    {   229,  5,  6,  0 },   // U+0055
+    {   234,  5,  6,  0 },   // U+0056
+    {   239,  5,  6,  0 },   // U+0057
+    {   244,  5,  6,  0 },   // U+0058
+    {   249,  5,  6,  0 },   // U+0059
+    {   254,  5,  6,  0 },   // U+005A
+    {   259,  3,  4,  0 },   // U+005B
+    {   262,  5,  6,  0 },   // U+005C
+    {   267,  3,  4,  0 },   // U+005D
+    {   270,  5,  6,  0 },   // U+005E
+    {   275,  5,  6,  0 },   // U+005F
+    {   280,  3,  4,  0 },   // U+0060
+    {   283,  5,  6,  0 },   // U+0061
+    {   288,  5,  6,  0 },   // U+0062
+    {   293,  5,  6,  0 },   // U+0063
+    {   298,  5,  6,  0 },   // U+0064
+    {   303,  5,  6,  0 },   // U+0065
+    {   308,  5,  6,  0 },   // U+0066
+    {   313,  5,  6,  0 },   // U+0067
+    {   318,  5,  6,  0 },   // U+0068
+    {   323,  3,  4,  0 },   // U+0069
+    {   326,  4,  5,  0 },   // U+006A
+    {   330,  4,  5,  0 },   // U+006B
+    {   334,  3,  4,  0 },   // U+006C
+    {   337,  5,  6,  0 },   // U+006D
+    {   342,  5,  6,  0 },   // U+006E
+    {   347,  5,  6,  0 },   // U+006F
+    {   352,  5,  6,  0 },   // U+0070
+    {   357,  5,  6,  0 },   // U+0071
+    {   362,  5,  6,  0 },   // U+0072
+    {   367,  5,  6,  0 },   // U+0073
+    {   372,  5,  6,  0 },   // U+0074
+    {   377,  5,  6,  0 },   // U+0075
+    {   382,  5,  6,  0 },   // U+0076
+    {   387,  5,  6,  0 },   // U+0077
+    {   392,  5,  6,  0 },   // U+0078
+    {   397,  5,  6,  0 },   // U+0079
+    {   402,  5,  6,  0 },   // U+007A
+    {   407,  3,  4,  0 },   // U+007B
+    {   410,  1,  2,  0 },   // U+007C
+    {   411,  3,  4,  0 },   // U+007D
+    {   414,  5,  6,  0 },   // U+007E
+};
+
+static const ssd1306_kern_t font5x7_kerning[10] = {
+    { 0x004C, 0x0054, -1 },
+    { 0x0054, 0x0061, -1 },
+    { 0x0054, 0x0065, -1 },
+    { 0x0054, 0x006F, -1 },
+    { 0x0056, 0x0061, -1 },
+    { 0x0056, 0x006F, -1 },
+    { 0x0057, 0x0061, -1 },
+    { 0x0059, 0x0061, -1 },
+    { 0x0059, 0x006F, -1 },
+    { 0x0072, 0x002E, -1 },
+};
+
+static const ssd1306_font_t font5x7 = {
+    .bitmap = font5x7_bitmap,
+    .glyphs = font5x7_glyphs,
+    .kerning = font5x7_kerning,
+    .kerningLen = 10,
+    .ranges = NULL,
+    .rangeLen = 0,
+    .first = 0x20,
+    .last = 0x7E,
+    .height = 8,
+    .ascent = 7,
+};
+
+#endif /* MAIN_FONT5X7_H_ */
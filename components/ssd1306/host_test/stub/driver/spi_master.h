@@ -0,0 +1,3 @@
+#pragma once
+
+typedef void * spi_device_handle_t;
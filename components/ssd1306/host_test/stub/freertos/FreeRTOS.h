@@ -0,0 +1,10 @@
+// Just enough of FreeRTOS for ssd1306.h on the host. Not an implementation.
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef int portMUX_TYPE;
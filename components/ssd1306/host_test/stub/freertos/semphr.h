@@ -0,0 +1,5 @@
+#pragma once
+#include "FreeRTOS.h"
+
+typedef void * SemaphoreHandle_t;
+typedef struct { void * pvDummy[8]; } StaticSemaphore_t;
@@ -0,0 +1,196 @@
+// Host test of ssd1306_lock.c with the pthread backend.
+// Build and run with: make -C components/ssd1306/host_test
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "ssd1306.h"
+#include "ssd1306_private.h"
+
+static int failed = 0;
+
+#define CHECK(cond) do { \
+	if (!(cond)) { \
+		fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #cond); \
+		failed++; \
+	} \
+} while (0)
+
+static void sleep_ms(int ms)
+{
+	struct timespec ts = { ms / 1000, (ms % 1000) * 1000000L };
+	nanosleep(&ts, NULL);
+}
+
+static SSD1306_t dev;
+static volatile int step;
+
+static void wait_step(int value)
+{
+	while (__atomic_load_n(&step, __ATOMIC_ACQUIRE) < value) sleep_ms(1);
+}
+
+static void set_step(int value)
+{
+	__atomic_store_n(&step, value, __ATOMIC_RELEASE);
+}
+
+// Locks of a device without ssd1306_enable_lock do nothing.
+static void test_disabled(void)
+{
+	SSD1306_t plain;
+	memset(&plain, 0, sizeof(plain));
+	plain._pages = 8;
+	ssd1306_lock_region(&plain, 0, 7);
+	ssd1306_lock(&plain);
+	ssd1306_unlock(&plain);
+	CHECK(_ssd1306_lock_flush(&plain, 3));
+	ssd1306_unlock_region(&plain, 0, 7);
+	ssd1306_disable_lock(&plain);
+}
+
+static void * hold_lower(void * arg)
+{
+	ssd1306_lock_region(&dev, 4, 7);
+	set_step(1);
+	wait_step(2);
+	ssd1306_unlock_region(&dev, 4, 7);
+	return NULL;
+}
+
+// Regions of two tasks are held at the same time. Held pages are taken again.
+static void test_regions(void)
+{
+	set_step(0);
+	ssd1306_lock_region(&dev, 0, 3);
+	ssd1306_lock_region(&dev, 1, 2);
+	pthread_t thread;
+	pthread_create(&thread, NULL, hold_lower, NULL);
+	wait_step(1);
+	ssd1306_unlock_region(&dev, 1, 2);
+	ssd1306_unlock_region(&dev, 0, 3);
+	set_step(2);
+	pthread_join(thread, NULL);
+}
+
+static volatile int taken;
+
+static void * take_page(void * arg)
+{
+	ssd1306_lock_region(&dev, 2, 2);
+	__atomic_store_n(&taken, 1, __ATOMIC_RELEASE);
+	ssd1306_unlock_region(&dev, 2, 2);
+	return NULL;
+}
+
+// A page held by one task is not taken by another one until it is released.
+static void test_exclusive(void)
+{
+	taken = 0;
+	ssd1306_lock_region(&dev, 2, 2);
+	pthread_t thread;
+	pthread_create(&thread, NULL, take_page, NULL);
+	sleep_ms(50);
+	CHECK(__atomic_load_n(&taken, __ATOMIC_ACQUIRE) == 0);
+	ssd1306_unlock_region(&dev, 2, 2);
+	pthread_join(thread, NULL);
+	CHECK(taken == 1);
+}
+
+static void * flush_free(void * arg)
+{
+	// Holding no page, the flush waits for page 5
+	bool locked = _ssd1306_lock_flush(&dev, 5);
+	__atomic_store_n(&taken, 1, __ATOMIC_RELEASE);
+	if (locked) ssd1306_unlock_region(&dev, 5, 5);
+	return (void *)(long)locked;
+}
+
+// With a region held, a flush takes free pages and skips pages held by another task.
+// Without a region, it waits.
+static void test_flush(void)
+{
+	set_step(0);
+	pthread_t thread;
+	pthread_create(&thread, NULL, hold_lower, NULL);
+	wait_step(1);
+
+	ssd1306_lock_region(&dev, 0, 3);
+	CHECK(_ssd1306_lock_flush(&dev, 2));
+	ssd1306_unlock_region(&dev, 2, 2);
+	CHECK(!_ssd1306_lock_flush(&dev, 5));
+	ssd1306_unlock_region(&dev, 0, 3);
+
+	taken = 0;
+	pthread_t flusher;
+	pthread_create(&flusher, NULL, flush_free, NULL);
+	sleep_ms(50);
+	CHECK(__atomic_load_n(&taken, __ATOMIC_ACQUIRE) == 0);
+	set_step(2);
+	pthread_join(thread, NULL);
+	void * locked;
+	pthread_join(flusher, &locked);
+	CHECK(locked != NULL);
+}
+
+#define ROUNDS 2000
+
+static void * render(void * arg)
+{
+	int base = (int)(long)arg;
+	for (int round=0; round<ROUNDS; round++) {
+		ssd1306_lock_region(&dev, base, base + 3);
+		for (int page=base; page<base+4; page++) {
+			memset(dev._page[page]._segs, round & 0xFF, 128);
+		}
+		// Flush all pages with the region held, as ssd1306_show_dirty does
+		for (int page=0; page<dev._pages; page++) {
+			if (!_ssd1306_lock_flush(&dev, page)) continue;
+			uint8_t first = dev._page[page]._segs[0];
+			for (int seg=1; seg<128; seg++) {
+				if (dev._page[page]._segs[seg] != first) __atomic_fetch_add(&failed, 1, __ATOMIC_RELAXED);
+			}
+			ssd1306_unlock_region(&dev, page, page);
+		}
+		ssd1306_unlock_region(&dev, base, base + 3);
+	}
+	return NULL;
+}
+
+// Two tasks render their regions and flush with them held. They never wait for each other
+// and never see a page the other one is writing.
+static void test_render_flush(void)
+{
+	pthread_t upper, lower;
+	pthread_create(&upper, NULL, render, (void *)0L);
+	pthread_create(&lower, NULL, render, (void *)4L);
+	pthread_join(upper, NULL);
+	pthread_join(lower, NULL);
+}
+
+int main(void)
+{
+	test_disabled();
+
+	memset(&dev, 0, sizeof(dev));
+	dev._width = 128;
+	dev._height = 64;
+	dev._pages = 8;
+	CHECK(ssd1306_enable_lock(&dev));
+	CHECK(ssd1306_enable_lock(&dev));
+	test_regions();
+	test_exclusive();
+	test_flush();
+	test_render_flush();
+	ssd1306_disable_lock(&dev);
+	CHECK(dev._lock == NULL);
+
+	if (failed) {
+		printf("test_lock: %d failed\n", failed);
+		return 1;
+	}
+	printf("test_lock: ok\n");
+	return 0;
+}
@@ -6,17 +6,11 @@
 #include "esp_log.h"
 
 #include "ssd1306.h"
+#include "ssd1306_private.h"
 #include "font8x8_basic.h"
 
 #define TAG "SSD1306"
 
-#define PACK8 __attribute__((aligned( __alignof__( uint8_t ) ), packed ))
-
-typedef union out_column_t {
-	uint32_t u32;
-	uint8_t  u8[4];
-} PACK8 out_column_t;
-
 void ssd1306_init(SSD1306_t * dev, int width, int height)
 {
 	if (dev->_address == SPIAddress) {
@@ -27,7 +21,18 @@ void ssd1306_init(SSD1306_t * dev, int width, int height)
 	// Initialize internal buffer
 	for (int i=0;i<dev->_pages;i++) {
 		memset(dev->_page[i]._segs, 0, 128);
+		dev->_page[i]._dirtyStart = dev->_width;
+		dev->_page[i]._dirtyEnd = -1;
 	}
+	dev->_zoomStart = -1;
+	dev->_scrollStart = 0;
+	dev->_scrollEnd = -1;
+	dev->_cursorX = 0;
+	dev->_cursorY = 0;
+	dev->_cursorLeft = 0;
+	// Initialize glyph cache
+	memset(dev->_glyph, 0, sizeof(dev->_glyph));
+	dev->_glyphTick = 0;
 }
 
 int ssd1306_get_width(SSD1306_t * dev)
@@ -45,16 +50,20 @@ int ssd1306_get_pages(SSD1306_t * dev)
 	return dev->_pages;
 }
 
+// With ssd1306_enable_lock, a page held by another task is skipped while a region is held.
+// That task sends its page with its own flush.
 void ssd1306_show_buffer(SSD1306_t * dev)
 {
-	if (dev->_address == SPIAddress) {
-		for (int page=0; page<dev->_pages;page++) {
+	for (int page=0; page<dev->_pages;page++) {
+		if (!_ssd1306_lock_flush(dev, page)) continue;
+		if (dev->_address == SPIAddress) {
 			spi_display_image(dev, page, 0, dev->_page[page]._segs, dev->_width);
-		}
-	} else {
-		for (int page=0; page<dev->_pages;page++) {
+		} else {
 			i2c_display_image(dev, page, 0, dev->_page[page]._segs, dev->_width);
 		}
+		dev->_page[page]._dirtyStart = dev->_width;
+		dev->_page[page]._dirtyEnd = -1;
+		ssd1306_unlock_region(dev, page, page);
 	}
 }
 
@@ -64,6 +73,7 @@ void ssd1306_set_buffer(SSD1306_t * dev, uint8_t * buffer)
 	for (int page=0; page<dev->_pages;page++) {
 		memcpy(&dev->_page[page]._segs, &buffer[index], 128);
 		index = index + 128;
+		ssd1306_mark_dirty(dev, page, 0, dev->_width-1);
 	}
 }
 
@@ -76,8 +86,84 @@ void ssd1306_get_buffer(SSD1306_t * dev, uint8_t * buffer)
 	}
 }
 
-void ssd1306_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width)
+// Mark segments start to end of page as changed in internal buffer.
+void ssd1306_mark_dirty(SSD1306_t * dev, int page, int start, int end)
+{
+	if (page < 0 || page >= dev->_pages) return;
+	if (start < 0) start = 0;
+	if (end >= dev->_width) end = dev->_width - 1;
+	if (start > end) return;
+	PAGE_t * _page = &dev->_page[page];
+	if (start < _page->_dirtyStart) _page->_dirtyStart = start;
+	if (end > _page->_dirtyEnd) _page->_dirtyEnd = end;
+}
+
+// Segments start to end of page were just sent, so they are no longer changed.
+// A sent range in the middle of the dirty span can not split it, so the span is kept.
+static void _ssd1306_mark_sent(SSD1306_t * dev, int page, int start, int end)
+{
+	PAGE_t * _page = &dev->_page[page];
+	if (start <= _page->_dirtyStart && end >= _page->_dirtyEnd) {
+		_page->_dirtyStart = dev->_width;
+		_page->_dirtyEnd = -1;
+	} else if (start <= _page->_dirtyStart && end >= _page->_dirtyStart) {
+		_page->_dirtyStart = end + 1;
+	} else if (start <= _page->_dirtyEnd && end >= _page->_dirtyEnd) {
+		_page->_dirtyEnd = start - 1;
+	}
+}
+
+// Show only the changed segments of internal buffer.
+// One transfer per changed page instead of a full screen.
+// With ssd1306_enable_lock, each page is held only while it is sent.
+// A page held by another task is skipped while a region is held, and stays dirty.
+void ssd1306_show_dirty(SSD1306_t * dev)
+{
+	for (int page=0; page<dev->_pages;page++) {
+		PAGE_t * _page = &dev->_page[page];
+		if (!_ssd1306_lock_flush(dev, page)) continue;
+		if (_page->_dirtyStart > _page->_dirtyEnd) {
+			ssd1306_unlock_region(dev, page, page);
+			continue;
+		}
+		int seg = _page->_dirtyStart;
+		int width = _page->_dirtyEnd - _page->_dirtyStart + 1;
+		if (dev->_address == SPIAddress) {
+			spi_display_image(dev, page, seg, &_page->_segs[seg], width);
+		} else {
+			i2c_display_image(dev, page, seg, &_page->_segs[seg], width);
+		}
+		_page->_dirtyStart = dev->_width;
+		_page->_dirtyEnd = -1;
+		ssd1306_unlock_region(dev, page, page);
+	}
+}
+
+// Show segments start to end of pages startPage to endPage of internal buffer.
+// For widgets that know which window they changed.
+// Like ssd1306_show_buffer, a page held by another task is skipped while a region is held.
+void ssd1306_show_window(SSD1306_t * dev, int startPage, int endPage, int start, int end)
+{
+	if (startPage < 0) startPage = 0;
+	if (endPage >= dev->_pages) endPage = dev->_pages - 1;
+	if (start < 0) start = 0;
+	if (end >= dev->_width) end = dev->_width - 1;
+	if (start > end) return;
+	for (int page=startPage; page<=endPage;page++) {
+		if (!_ssd1306_lock_flush(dev, page)) continue;
+		if (dev->_address == SPIAddress) {
+			spi_display_image(dev, page, start, &dev->_page[page]._segs[start], end - start + 1);
+		} else {
+			i2c_display_image(dev, page, start, &dev->_page[page]._segs[start], end - start + 1);
+		}
+		_ssd1306_mark_sent(dev, page, start, end);
+		ssd1306_unlock_region(dev, page, page);
+	}
+}
+
+void ssd1306_display_image(SSD1306_t * dev, int page, int seg, const uint8_t * images, int width)
 {
+	ssd1306_lock_region(dev, page, page);
 	if (dev->_address == SPIAddress) {
 		spi_display_image(dev, page, seg, images, width);
 	} else {
@@ -85,86 +171,181 @@ void ssd1306_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images,
 	}
 	// Set to internal buffer
 	memcpy(&dev->_page[page]._segs[seg], images, width);
+	_ssd1306_mark_sent(dev, page, seg, seg + width - 1);
+	ssd1306_unlock_region(dev, page, page);
 }
 
-void ssd1306_display_text(SSD1306_t * dev, int page, char * text, int text_len, bool invert)
+// Render text to internal buffer of the page from segment 0.
+// Returns the number of segments rendered.
+static int _ssd1306_render_text(SSD1306_t * dev, int page, char * text, int text_len, bool invert)
 {
-	if (page >= dev->_pages) return;
 	int _text_len = text_len;
-	if (_text_len > 16) _text_len = 16;
+	if (_text_len > dev->_width / 8) _text_len = dev->_width / 8;
 
-	uint8_t seg = 0;
-	uint8_t image[8];
-	for (uint8_t i = 0; i < _text_len; i++) {
-		memcpy(image, font8x8_basic_tr[(uint8_t)text[i]], 8);
-		if (invert) ssd1306_invert(image, 8);
-		if (dev->_flip) ssd1306_flip(image, 8);
-		ssd1306_display_image(dev, page, seg, image, 8);
-#if 0
+	uint8_t * segs = dev->_page[page]._segs;
+	for (int i = 0; i < _text_len; i++) {
+		uint8_t code = (uint8_t)text[i];
+		if (code >= 128) code = ' '; // font8x8_basic_tr is U+0000 - U+007F
+		memcpy(&segs[i*8], font8x8_basic_tr[code], 8);
+	}
+	int width = _text_len * 8;
+	if (invert) ssd1306_invert(segs, width);
+	if (dev->_flip) ssd1306_flip(segs, width);
+	return width;
+}
+
+// Render the whole text to internal buffer, then show it with one transfer.
+void ssd1306_display_text(SSD1306_t * dev, int page, char * text, int text_len, bool invert)
+{
+	if (page >= dev->_pages) return;
+	ssd1306_lock_region(dev, page, page);
+	int width = _ssd1306_render_text(dev, page, text, text_len, invert);
+	if (width > 0) {
 		if (dev->_address == SPIAddress) {
-			spi_display_image(dev, page, seg, image, 8);
+			spi_display_image(dev, page, 0, dev->_page[page]._segs, width);
 		} else {
-			i2c_display_image(dev, page, seg, image, 8);
+			i2c_display_image(dev, page, 0, dev->_page[page]._segs, width);
 		}
-#endif
-		seg = seg + 8;
+		_ssd1306_mark_sent(dev, page, 0, width - 1);
 	}
+	ssd1306_unlock_region(dev, page, page);
 }
 
-// by Coert Vonk
-void 
-ssd1306_display_text_x3(SSD1306_t * dev, int page, char * text, int text_len, bool invert)
+// Set text to internal buffer. Not show it.
+// Several lines can be shown together with ssd1306_show_dirty.
+void ssd1306_buffer_text(SSD1306_t * dev, int page, char * text, int text_len, bool invert)
 {
 	if (page >= dev->_pages) return;
-	int _text_len = text_len;
-	if (_text_len > 5) _text_len = 5;
-
-	uint8_t seg = 0;
-
-	for (uint8_t nn = 0; nn < _text_len; nn++) {
+	int width = _ssd1306_render_text(dev, page, text, text_len, invert);
+	ssd1306_mark_dirty(dev, page, 0, width - 1);
+}
 
-		uint8_t const * const in_columns = font8x8_basic_tr[(uint8_t)text[nn]];
+// Each bit of the nibble doubled
+static const uint8_t _expand_nibble[16] = {
+	0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F,
+	0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF
+};
 
-		// make the character 3x as high
-		out_column_t out_columns[8];
-		memset(out_columns, 0, sizeof(out_columns));
+// Make each bit of the column scale bits high.
+static uint64_t _stretch_column(uint8_t column, int scale)
+{
+	uint64_t bits = column;
+	if ((scale & (scale - 1)) == 0) {
+		// x2, x4 and x8 double the bits with the table
+		for (int height = 8; height < 8 * scale; height <<= 1) {
+			uint64_t doubled = 0;
+			for (int n = 0; n < height / 4; n++) {
+				doubled |= (uint64_t)_expand_nibble[(bits >> (n * 4)) & 0xF] << (n * 8);
+			}
+			bits = doubled;
+		}
+		return bits;
+	}
+	uint64_t run = (1ULL << scale) - 1;
+	uint64_t stretched = 0;
+	for (int bit = 0; bit < 8; bit++) {
+		if (column & (1 << bit)) stretched |= run << (bit * scale);
+	}
+	return stretched;
+}
 
-		for (uint8_t xx = 0; xx < 8; xx++) { // for each column (x-direction)
+// Get the glyph stretched scale times as high.
+// Expanded glyphs are cached, so repeated digits are not expanded again.
+static const uint64_t * _ssd1306_scaled_glyph(SSD1306_t * dev, uint8_t code, int scale)
+{
+	uint32_t tick = ++dev->_glyphTick;
+	GLYPH_t * oldest = &dev->_glyph[0];
+	for (int i = 0; i < SSD1306_GLYPH_CACHE; i++) {
+		GLYPH_t * glyph = &dev->_glyph[i];
+		if (glyph->_scale == scale && glyph->_code == code) {
+			glyph->_used = tick;
+			return glyph->_columns;
+		}
+		if (glyph->_used < oldest->_used) oldest = glyph;
+	}
 
-			uint32_t in_bitmask = 0b1;
-			uint32_t out_bitmask = 0b111;
+	oldest->_code = code;
+	oldest->_scale = scale;
+	oldest->_used = tick;
+	for (int xx = 0; xx < 8; xx++) {
+		oldest->_columns[xx] = _stretch_column(font8x8_basic_tr[code][xx], scale);
+	}
+	return oldest->_columns;
+}
 
-			for (uint8_t yy = 0; yy < 8; yy++) { // for pixel (y-direction)
-				if (in_columns[xx] & in_bitmask) {
-					out_columns[xx].u32 |= out_bitmask;
-				}
-				in_bitmask <<= 1;
-				out_bitmask <<= 3;
+// Render text xscale times as wide and yscale times as high to internal buffer.
+// The text starts at segment 0 of page and uses yscale pages.
+// Returns the number of segments rendered.
+static int _ssd1306_render_text_scaled(SSD1306_t * dev, int page, char * text, int text_len, int xscale, int yscale, bool invert)
+{
+	if (xscale < 1 || yscale < 1 || yscale > 8) return 0;
+	int cell = 8 * xscale;
+	int _text_len = text_len;
+	if (_text_len > dev->_width / cell) _text_len = dev->_width / cell;
+	if (_text_len <= 0) return 0;
+
+	int pages = yscale;
+	if (page + pages > dev->_pages) pages = dev->_pages - page;
+	// Glyph cache is shared by all pages
+	ssd1306_lock(dev);
+	for (int i = 0; i < _text_len; i++) {
+		uint8_t code = (uint8_t)text[i];
+		if (code >= 128) code = ' '; // font8x8_basic_tr is U+0000 - U+007F
+		const uint64_t * columns = _ssd1306_scaled_glyph(dev, code, yscale);
+		for (int yy = 0; yy < pages; yy++) {
+			uint8_t * image = &dev->_page[page+yy]._segs[i*cell];
+			for (int xx = 0; xx < 8; xx++) {
+				memset(&image[xx*xscale], (uint8_t)(columns[xx] >> (yy*8)), xscale);
 			}
 		}
+	}
+	ssd1306_unlock(dev);
 
-		// render character in 8 column high pieces, making them 3x as wide
-		for (uint8_t yy = 0; yy < 3; yy++)	{ // for each group of 8 pixels high (y-direction)
+	int width = _text_len * cell;
+	for (int yy = 0; yy < pages; yy++) {
+		uint8_t * image = dev->_page[page+yy]._segs;
+		if (invert) ssd1306_invert(image, width);
+		if (dev->_flip) ssd1306_flip(image, width);
+	}
+	return width;
+}
 
-			uint8_t image[24];
-			for (uint8_t xx = 0; xx < 8; xx++) { // for each column (x-direction)
-				image[xx*3+0] = 
-				image[xx*3+1] = 
-				image[xx*3+2] = out_columns[xx].u8[yy];
-			}
-			if (invert) ssd1306_invert(image, 24);
-			if (dev->_flip) ssd1306_flip(image, 24);
-			if (dev->_address == SPIAddress) {
-				spi_display_image(dev, page+yy, seg, image, 24);
-			} else {
-				i2c_display_image(dev, page+yy, seg, image, 24);
-			}
-			memcpy(&dev->_page[page+yy]._segs[seg], image, 24);
+// Show text xscale times as wide and yscale times as high.
+// Each page of the text is shown with one transfer.
+void ssd1306_display_text_scaled(SSD1306_t * dev, int page, char * text, int text_len, int xscale, int yscale, bool invert)
+{
+	if (page < 0 || page >= dev->_pages) return;
+	ssd1306_lock_region(dev, page, page+yscale-1);
+	int width = _ssd1306_render_text_scaled(dev, page, text, text_len, xscale, yscale, invert);
+	for (int yy = 0; yy < yscale && width > 0; yy++) {
+		if (page+yy >= dev->_pages) break;
+		if (dev->_address == SPIAddress) {
+			spi_display_image(dev, page+yy, 0, dev->_page[page+yy]._segs, width);
+		} else {
+			i2c_display_image(dev, page+yy, 0, dev->_page[page+yy]._segs, width);
 		}
-		seg = seg + 24;
+		_ssd1306_mark_sent(dev, page+yy, 0, width - 1);
+	}
+	ssd1306_unlock_region(dev, page, page+yscale-1);
+}
+
+// Set scaled text to internal buffer. Not show it.
+void ssd1306_buffer_text_scaled(SSD1306_t * dev, int page, char * text, int text_len, int xscale, int yscale, bool invert)
+{
+	if (page < 0 || page >= dev->_pages) return;
+	int width = _ssd1306_render_text_scaled(dev, page, text, text_len, xscale, yscale, invert);
+	for (int yy = 0; yy < yscale; yy++) {
+		ssd1306_mark_dirty(dev, page+yy, 0, width - 1);
 	}
 }
 
+// by Coert Vonk
+void 
+ssd1306_display_text_x3(SSD1306_t * dev, int page, char * text, int text_len, bool invert)
+{
+	ssd1306_display_text_scaled(dev, page, text, text_len, 3, 3, invert);
+}
+
 void ssd1306_clear_screen(SSD1306_t * dev, bool invert)
 {
 	char space[16];
@@ -212,13 +393,17 @@ void ssd1306_scroll_text(SSD1306_t * dev, char * text, int text_len, bool invert
 	ESP_LOGD(TAG, "dev->_scEnable=%d", dev->_scEnable);
 	if (dev->_scEnable == false) return;
 
-	void (*func)(SSD1306_t * dev, int page, int seg, uint8_t * images, int width);
+	void (*func)(SSD1306_t * dev, int page, int seg, const uint8_t * images, int width);
 	if (dev->_address == SPIAddress) {
 		func = spi_display_image;
 	} else {
 		func = i2c_display_image;
 	}
 
+	// The scrolled lines are held together, so no other line moves between them
+	int first = (dev->_scStart < dev->_scEnd) ? dev->_scStart : dev->_scEnd;
+	int last = (dev->_scStart < dev->_scEnd) ? dev->_scEnd : dev->_scStart;
+	ssd1306_lock_region(dev, first, last);
 	int srcIndex = dev->_scEnd - dev->_scDirection;
 	while(1) {
 		int dstIndex = srcIndex + dev->_scDirection;
@@ -235,6 +420,7 @@ void ssd1306_scroll_text(SSD1306_t * dev, char * text, int text_len, bool invert
 	if (_text_len > 16) _text_len = 16;
 	
 	ssd1306_display_text(dev, srcIndex, text, text_len, invert);
+	ssd1306_unlock_region(dev, first, last);
 }
 
 void ssd1306_scroll_clear(SSD1306_t * dev)
@@ -253,161 +439,294 @@ void ssd1306_scroll_clear(SSD1306_t * dev)
 }
 
 
-void ssd1306_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll)
+// Rotate a window of internal buffer by step pixels. Pages and segments must be in range.
+// Returns false when nothing moved.
+static bool _ssd1306_wrap_window(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int startPage, int endPage, int start, int end, int step)
 {
-	if (dev->_address == SPIAddress) {
-		spi_hardware_scroll(dev, scroll);
+	int width = end - start + 1;
+	int height = (endPage - startPage + 1) * 8;
+	if (step < 1) step = 1;
+
+	if (scroll == SCROLL_RIGHT || scroll == SCROLL_LEFT) {
+		step = step % width;
+		if (step == 0) return false;
+		uint8_t save[128];
+		for (int page=startPage;page<=endPage;page++) {
+			uint8_t * segs = dev->_page[page]._segs;
+			if (scroll == SCROLL_RIGHT) {
+				memcpy(save, &segs[end-step+1], step);
+				memmove(&segs[start+step], &segs[start], width-step);
+				memcpy(&segs[start], save, step);
+			} else {
+				memcpy(save, &segs[start], step);
+				memmove(&segs[start], &segs[start+step], width-step);
+				memcpy(&segs[end-step+1], save, step);
+			}
+		}
+	} else if (scroll == SCROLL_UP || scroll == SCROLL_DOWN) {
+		step = step % height;
+		if (step == 0) return false;
+		// Bytes of a flipped panel are bit reversed, so the column gathered from the last page
+		// is the column upside down. Rotating it the other way needs no byte reversal.
+		bool up = (scroll == SCROLL_UP) != dev->_flip;
+		uint64_t mask = (height == 64) ? ~(uint64_t)0 : (((uint64_t)1 << height) - 1);
+		for (int seg=start;seg<=end;seg++) {
+			uint64_t word = 0;
+			for (int page=startPage;page<=endPage;page++) {
+				int bit = dev->_flip ? (endPage - page) * 8 : (page - startPage) * 8;
+				word |= (uint64_t)dev->_page[page]._segs[seg] << bit;
+			}
+			if (up) {
+				word = (word >> step) | (word << (height - step));
+			} else {
+				word = (word << step) | (word >> (height - step));
+			}
+			word &= mask;
+			for (int page=startPage;page<=endPage;page++) {
+				int bit = dev->_flip ? (endPage - page) * 8 : (page - startPage) * 8;
+				dev->_page[page]._segs[seg] = (uint8_t)(word >> bit);
+			}
+		}
 	} else {
-		i2c_hardware_scroll(dev, scroll);
+		ESP_LOGE(TAG, "Window wrap around is for SCROLL_RIGHT, SCROLL_LEFT, SCROLL_UP and SCROLL_DOWN");
+		return false;
 	}
+	return true;
 }
 
-// delay = 0 : display with no wait
-// delay > 0 : display with wait
-// delay < 0 : no display
-void ssd1306_wrap_arround(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int start, int end, int8_t delay)
+// Scroll the whole panel by hardware, one pixel every 2 frames.
+// SCROLL_STOP sends the stop command and display start line 0, then sends the scrolled pages again,
+// because the controller leaves GDDRAM and the start line moved.
+void ssd1306_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll)
 {
-	if (scroll == SCROLL_RIGHT) {
-		int _start = start; // 0 to 7
-		int _end = end; // 0 to 7
-		if (_end >= dev->_pages) _end = dev->_pages - 1;
-		uint8_t wk;
-		//for (int page=0;page<dev->_pages;page++) {
-		for (int page=_start;page<=_end;page++) {
-			wk = dev->_page[page]._segs[127];
-			for (int seg=127;seg>0;seg--) {
-				dev->_page[page]._segs[seg] = dev->_page[page]._segs[seg-1];
-			}
-			dev->_page[page]._segs[0] = wk;
+	if (scroll == SCROLL_STOP) {
+		if (dev->_address == SPIAddress) {
+			spi_hardware_scroll(dev, NULL);
+		} else {
+			i2c_hardware_scroll(dev, NULL);
 		}
+		ssd1306_show_window(dev, dev->_scrollStart, dev->_scrollEnd, 0, dev->_width-1);
+		dev->_scrollStart = 0;
+		dev->_scrollEnd = -1;
+		return;
+	}
 
-	} else if (scroll == SCROLL_LEFT) {
-		int _start = start; // 0 to 7
-		int _end = end; // 0 to 7
-		if (_end >= dev->_pages) _end = dev->_pages - 1;
-		uint8_t wk;
-		//for (int page=0;page<dev->_pages;page++) {
-		for (int page=_start;page<=_end;page++) {
-			wk = dev->_page[page]._segs[0];
-			for (int seg=0;seg<127;seg++) {
-				dev->_page[page]._segs[seg] = dev->_page[page]._segs[seg+1];
-			}
-			dev->_page[page]._segs[127] = wk;
-		}
+	ssd1306_scroll_config_t config = {
+		.horizontal = SCROLL_STOP,
+		.startPage = 0,
+		.endPage = dev->_pages-1,
+		.start = 0,
+		.end = dev->_width-1,
+		.vertical = 0,
+		.areaTop = 0,
+		.areaRows = dev->_height,
+		.frames = SCROLL_FRAMES_2,
+	};
+	if (scroll == SCROLL_RIGHT || scroll == SCROLL_LEFT) config.horizontal = scroll;
+	if (scroll == SCROLL_UP) config.vertical = 1;
+	if (scroll == SCROLL_DOWN) config.vertical = -1;
+	ssd1306_hardware_scroll_config(dev, &config);
+}
 
-	} else if (scroll == SCROLL_UP) {
-		int _start = start; // 0 to {width-1}
-		int _end = end; // 0 to {width-1}
-		if (_end >= dev->_width) _end = dev->_width - 1;
-		uint8_t wk0;
-		uint8_t wk1;
-		uint8_t wk2;
-		uint8_t save[128];
-		// Save pages 0
-		for (int seg=0;seg<128;seg++) {
-			save[seg] = dev->_page[0]._segs[seg];
-		}
-		// Page0 to Page6
-		for (int page=0;page<dev->_pages-1;page++) {
-			//for (int seg=0;seg<128;seg++) {
-			for (int seg=_start;seg<=_end;seg++) {
-				wk0 = dev->_page[page]._segs[seg];
-				wk1 = dev->_page[page+1]._segs[seg];
-				if (dev->_flip) wk0 = ssd1306_rotate_byte(wk0);
-				if (dev->_flip) wk1 = ssd1306_rotate_byte(wk1);
-				if (seg == 0) {
-					ESP_LOGD(TAG, "b page=%d wk0=%02x wk1=%02x", page, wk0, wk1);
-				}
-				wk0 = wk0 >> 1;
-				wk1 = wk1 & 0x01;
-				wk1 = wk1 << 7;
-				wk2 = wk0 | wk1;
-				if (seg == 0) {
-					ESP_LOGD(TAG, "a page=%d wk0=%02x wk1=%02x wk2=%02x", page, wk0, wk1, wk2);
-				}
-				if (dev->_flip) wk2 = ssd1306_rotate_byte(wk2);
-				dev->_page[page]._segs[seg] = wk2;
-			}
-		}
-		// Page7
-		int pages = dev->_pages-1;
-		//for (int seg=0;seg<128;seg++) {
-		for (int seg=_start;seg<=_end;seg++) {
-			wk0 = dev->_page[pages]._segs[seg];
-			wk1 = save[seg];
-			if (dev->_flip) wk0 = ssd1306_rotate_byte(wk0);
-			if (dev->_flip) wk1 = ssd1306_rotate_byte(wk1);
-			wk0 = wk0 >> 1;
-			wk1 = wk1 & 0x01;
-			wk1 = wk1 << 7;
-			wk2 = wk0 | wk1;
-			if (dev->_flip) wk2 = ssd1306_rotate_byte(wk2);
-			dev->_page[pages]._segs[seg] = wk2;
-		}
+// Start hardware scroll. The controller moves the pixels, so there is no transfer per step.
+// Stop it with ssd1306_hardware_scroll(dev, SCROLL_STOP).
+void ssd1306_hardware_scroll_config(SSD1306_t * dev, const ssd1306_scroll_config_t * config)
+{
+	ssd1306_scroll_config_t _config = *config;
+	if (_config.startPage < 0) _config.startPage = 0;
+	if (_config.endPage >= dev->_pages) _config.endPage = dev->_pages - 1;
+	if (_config.start < 0) _config.start = 0;
+	if (_config.end >= dev->_width) _config.end = dev->_width - 1;
+	if (_config.areaTop < 0) _config.areaTop = 0;
+	if (_config.areaTop + _config.areaRows > dev->_height) _config.areaRows = dev->_height - _config.areaTop;
+	if (_config.startPage > _config.endPage || _config.start > _config.end) {
+		ESP_LOGE(TAG, "hardware scroll window is empty");
+		return;
+	}
+	if (_config.vertical == 0 && _config.horizontal == SCROLL_STOP) {
+		ESP_LOGE(TAG, "hardware scroll needs horizontal or vertical");
+		return;
+	}
+	if (_config.vertical != 0 && _config.areaRows <= 0) {
+		ESP_LOGE(TAG, "vertical scroll area is empty");
+		return;
+	}
 
-	} else if (scroll == SCROLL_DOWN) {
-		int _start = start; // 0 to {width-1}
-		int _end = end; // 0 to {width-1}
-		if (_end >= dev->_width) _end = dev->_width - 1;
-		uint8_t wk0;
-		uint8_t wk1;
-		uint8_t wk2;
-		uint8_t save[128];
-		// Save pages 7
-		int pages = dev->_pages-1;
-		for (int seg=0;seg<128;seg++) {
-			save[seg] = dev->_page[pages]._segs[seg];
-		}
-		// Page7 to Page1
-		for (int page=pages;page>0;page--) {
-			//for (int seg=0;seg<128;seg++) {
-			for (int seg=_start;seg<=_end;seg++) {
-				wk0 = dev->_page[page]._segs[seg];
-				wk1 = dev->_page[page-1]._segs[seg];
-				if (dev->_flip) wk0 = ssd1306_rotate_byte(wk0);
-				if (dev->_flip) wk1 = ssd1306_rotate_byte(wk1);
-				if (seg == 0) {
-					ESP_LOGD(TAG, "b page=%d wk0=%02x wk1=%02x", page, wk0, wk1);
-				}
-				wk0 = wk0 << 1;
-				wk1 = wk1 & 0x80;
-				wk1 = wk1 >> 7;
-				wk2 = wk0 | wk1;
-				if (seg == 0) {
-					ESP_LOGD(TAG, "a page=%d wk0=%02x wk1=%02x wk2=%02x", page, wk0, wk1, wk2);
-				}
-				if (dev->_flip) wk2 = ssd1306_rotate_byte(wk2);
-				dev->_page[page]._segs[seg] = wk2;
-			}
-		}
-		// Page0
-		//for (int seg=0;seg<128;seg++) {
-		for (int seg=_start;seg<=_end;seg++) {
-			wk0 = dev->_page[0]._segs[seg];
-			wk1 = save[seg];
-			if (dev->_flip) wk0 = ssd1306_rotate_byte(wk0);
-			if (dev->_flip) wk1 = ssd1306_rotate_byte(wk1);
-			wk0 = wk0 << 1;
-			wk1 = wk1 & 0x80;
-			wk1 = wk1 >> 7;
-			wk2 = wk0 | wk1;
-			if (dev->_flip) wk2 = ssd1306_rotate_byte(wk2);
-			dev->_page[0]._segs[seg] = wk2;
+	// Remember what to send again when scroll stops
+	if (_config.vertical != 0) {
+		dev->_scrollStart = 0;
+		dev->_scrollEnd = dev->_pages - 1;
+	} else {
+		dev->_scrollStart = _config.startPage;
+		dev->_scrollEnd = _config.endPage;
+	}
+
+	// When flipped, page 0 is at the bottom of GDDRAM and rows run upward
+	if (dev->_flip) {
+		int startPage = _config.startPage;
+		_config.startPage = dev->_pages - 1 - _config.endPage;
+		_config.endPage = dev->_pages - 1 - startPage;
+		_config.areaTop = dev->_height - _config.areaTop - _config.areaRows;
+		_config.vertical = -_config.vertical;
+	}
+	// Vertical offset is rows up within the area
+	if (_config.vertical != 0) {
+		_config.vertical = _config.vertical % _config.areaRows;
+		if (_config.vertical < 0) _config.vertical = _config.vertical + _config.areaRows;
+		if (_config.vertical == 0) {
+			ESP_LOGW(TAG, "vertical scroll of %d rows does not move", config->vertical);
 		}
+	}
+
+	// Pure vertical scroll moves no page sideways, so the page range is 0 to 0
+	if (_config.vertical != 0 && _config.horizontal == SCROLL_STOP) {
+		_config.startPage = 0;
+		_config.endPage = 0;
+	}
+
+	if (dev->_address == SPIAddress) {
+		spi_hardware_scroll(dev, &_config);
+	} else {
+		i2c_hardware_scroll(dev, &_config);
+	}
+}
+
+// Scroll segments start to end of pages startPage to endPage by one column in GDDRAM.
+// Internal buffer is rotated the same way, so it stays the same as the panel.
+// The controller needs 2 frames between two content scrolls.
+void ssd1306_content_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int startPage, int endPage, int start, int end)
+{
+	if (scroll != SCROLL_RIGHT && scroll != SCROLL_LEFT) {
+		ESP_LOGE(TAG, "content scroll is for SCROLL_RIGHT and SCROLL_LEFT");
+		return;
+	}
+	if (startPage < 0) startPage = 0;
+	if (endPage >= dev->_pages) endPage = dev->_pages - 1;
+	if (start < 0) start = 0;
+	if (end >= dev->_width) end = dev->_width - 1;
+	if (startPage > endPage || start > end) return;
+
+	ssd1306_scroll_config_t config = {
+		.horizontal = scroll,
+		.startPage = dev->_flip ? dev->_pages - 1 - endPage : startPage,
+		.endPage = dev->_flip ? dev->_pages - 1 - startPage : endPage,
+		.start = start,
+		.end = end,
+	};
+	if (dev->_address == SPIAddress) {
+		spi_content_scroll(dev, &config);
+	} else {
+		i2c_content_scroll(dev, &config);
+	}
+	_ssd1306_wrap_window(dev, scroll, startPage, endPage, start, end, 1);
+}
+
+// Zoom pages start to start + pages/2 - 1 to the whole panel.
+// The controller doubles every row, so half-height content fills the screen.
+// start < 0 : back to normal
+void ssd1306_hardware_zoom(SSD1306_t * dev, int start)
+{
+	ESP_LOGD(TAG, "hardware_zoom start=%d _pages=%d", start, dev->_pages);
+	bool enable = (start >= 0);
+	if (enable && start > dev->_pages / 2) {
+		ESP_LOGE(TAG, "zoom start page %d is out of range", start);
+		return;
+	}
+	// Zoom works only with alternative COM pin configuration
+	if (enable && dev->_height != 64) {
+		ESP_LOGW(TAG, "hardware zoom needs 128x64 panel");
+		return;
+	}
 
+	// Display start line is the top row of the zoomed window.
+	// When flipped, page 0 is at the bottom of GDDRAM.
+	int line = 0;
+	if (enable) {
+		line = start * 8;
+		if (dev->_flip) line = dev->_height / 2 - start * 8;
+	}
+	if (dev->_address == SPIAddress) {
+		spi_hardware_zoom(dev, line, enable);
+	} else {
+		i2c_hardware_zoom(dev, line, enable);
 	}
+	dev->_zoomStart = enable ? start : -1;
+}
+
+// Show GDDRAM row line at the top of the panel.
+// Rows above it are shown at the bottom, so the panel scrolls without writing GDDRAM.
+void ssd1306_display_start_line(SSD1306_t * dev, int line)
+{
+	if (dev->_address == SPIAddress) {
+		spi_display_start_line(dev, line);
+	} else {
+		i2c_display_start_line(dev, line);
+	}
+}
+
+// Show text on line of the zoomed window, xscale times as wide.
+// Hardware doubles the rows, so the text is twice as high with one page of transfer.
+void ssd1306_display_text_zoom(SSD1306_t * dev, int line, char * text, int text_len, int xscale, bool invert)
+{
+	if (dev->_zoomStart < 0) {
+		ESP_LOGE(TAG, "hardware zoom is not enabled");
+		return;
+	}
+	if (line < 0 || line >= dev->_pages / 2) return;
+	int page = dev->_zoomStart + line;
+	ssd1306_lock_region(dev, page, page);
+	int width = _ssd1306_render_text_scaled(dev, page, text, text_len, xscale, 1, invert);
+	if (width > 0) {
+		if (dev->_address == SPIAddress) {
+			spi_display_image(dev, page, 0, dev->_page[page]._segs, width);
+		} else {
+			i2c_display_image(dev, page, 0, dev->_page[page]._segs, width);
+		}
+		_ssd1306_mark_sent(dev, page, 0, width - 1);
+	}
+	ssd1306_unlock_region(dev, page, page);
+}
+
+// Wrap around a window of pages startPage to endPage and segments start to end by step pixels.
+// SCROLL_RIGHT and SCROLL_LEFT rotate each page of the window with memmove.
+// SCROLL_UP and SCROLL_DOWN gather each column of the window into a 64 bit word and rotate it once.
+// Only the window is sent.
+// delay = 0 : display with no wait
+// delay > 0 : display with wait
+// delay < 0 : no display. The window is marked dirty for ssd1306_show_dirty
+void ssd1306_wrap_arround_window(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int startPage, int endPage, int start, int end, int step, int8_t delay)
+{
+	if (startPage < 0) startPage = 0;
+	if (endPage >= dev->_pages) endPage = dev->_pages - 1;
+	if (start < 0) start = 0;
+	if (end >= dev->_width) end = dev->_width - 1;
+	if (startPage > endPage || start > end) return;
+	if (!_ssd1306_wrap_window(dev, scroll, startPage, endPage, start, end, step)) return;
 
 	if (delay >= 0) {
-		for (int page=0;page<dev->_pages;page++) {
-			if (dev->_address == SPIAddress) {
-				spi_display_image(dev, page, 0, dev->_page[page]._segs, 128);
-			} else {
-				i2c_display_image(dev, page, 0, dev->_page[page]._segs, 128);
-			}
+		for (int page=startPage;page<=endPage;page++) {
+			ssd1306_show_window(dev, page, page, start, end);
 			if (delay) vTaskDelay(delay);
 		}
+	} else {
+		for (int page=startPage;page<=endPage;page++) {
+			ssd1306_mark_dirty(dev, page, start, end);
+		}
 	}
+}
 
+// delay = 0 : display with no wait
+// delay > 0 : display with wait
+// delay < 0 : no display
+void ssd1306_wrap_arround(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int start, int end, int8_t delay)
+{
+	if (scroll == SCROLL_RIGHT || scroll == SCROLL_LEFT) {
+		// start and end are pages
+		ssd1306_wrap_arround_window(dev, scroll, start, end, 0, dev->_width-1, 1, delay);
+	} else if (scroll == SCROLL_UP || scroll == SCROLL_DOWN) {
+		// start and end are segments
+		ssd1306_wrap_arround_window(dev, scroll, 0, dev->_pages-1, start, end, 1, delay);
+	}
 }
 
 void ssd1306_bitmaps(SSD1306_t * dev, int xpos, int ypos, uint8_t * bitmap, int width, int height, bool invert)
@@ -466,66 +785,17 @@ void ssd1306_bitmaps(SSD1306_t * dev, int xpos, int ypos, uint8_t * bitmap, int
 
 
 // Set pixel to internal buffer. Not show it.
+// Kept for compatibility. Same as ssd1306_set_pixel.
 void _ssd1306_pixel(SSD1306_t * dev, int xpos, int ypos, bool invert)
 {
-	uint8_t _page = (ypos / 8);
-	uint8_t _bits = (ypos % 8);
-	uint8_t _seg = xpos;
-	uint8_t wk0 = dev->_page[_page]._segs[_seg];
-	uint8_t wk1 = 1 << _bits;
-	ESP_LOGD(TAG, "ypos=%d _page=%d _bits=%d wk0=0x%02x wk1=0x%02x", ypos, _page, _bits, wk0, wk1);
-	if (invert) {
-		wk0 = wk0 & ~wk1;
-	} else {
-		wk0 = wk0 | wk1;
-	}
-	if (dev->_flip) wk0 = ssd1306_rotate_byte(wk0);
-	ESP_LOGD(TAG, "wk0=0x%02x wk1=0x%02x", wk0, wk1);
-	dev->_page[_page]._segs[_seg] = wk0;
+	ssd1306_set_pixel(dev, xpos, ypos, invert);
 }
 
 // Set line to internal buffer. Not show it.
+// Kept for compatibility. Same as ssd1306_line.
 void _ssd1306_line(SSD1306_t * dev, int x1, int y1, int x2, int y2,  bool invert)
 {
-	int i;
-	int dx,dy;
-	int sx,sy;
-	int E;
-
-	/* distance between two points */
-	dx = ( x2 > x1 ) ? x2 - x1 : x1 - x2;
-	dy = ( y2 > y1 ) ? y2 - y1 : y1 - y2;
-
-	/* direction of two point */
-	sx = ( x2 > x1 ) ? 1 : -1;
-	sy = ( y2 > y1 ) ? 1 : -1;
-
-	/* inclination < 1 */
-	if ( dx > dy ) {
-		E = -dx;
-		for ( i = 0 ; i <= dx ; i++ ) {
-			_ssd1306_pixel(dev, x1, y1, invert);
-			x1 += sx;
-			E += 2 * dy;
-			if ( E >= 0 ) {
-			y1 += sy;
-			E -= 2 * dx;
-		}
-	}
-
-	/* inclination >= 1 */
-	} else {
-		E = -dy;
-		for ( i = 0 ; i <= dy ; i++ ) {
-			_ssd1306_pixel(dev, x1, y1, invert);
-			y1 += sy;
-			E += 2 * dx;
-			if ( E >= 0 ) {
-				x1 += sx;
-				E -= 2 * dy;
-			}
-		}
-	}
+	ssd1306_line(dev, x1, y1, x2, y2, invert);
 }
 
 void ssd1306_invert(uint8_t *buf, size_t blen)
@@ -569,18 +839,16 @@ uint8_t ssd1306_copy_bit(uint8_t src, int srcBits, uint8_t dst, int dstBits)
 // Rotate 8-bit data
 // 0x12-->0x48
 uint8_t ssd1306_rotate_byte(uint8_t ch1) {
-	uint8_t ch2 = 0;
-	for (int j=0;j<8;j++) {
-		ch2 = (ch2 << 1) + (ch1 & 0x01);
-		ch1 = ch1 >> 1;
-	}
-	return ch2;
+	ch1 = (ch1 & 0xF0) >> 4 | (ch1 & 0x0F) << 4;
+	ch1 = (ch1 & 0xCC) >> 2 | (ch1 & 0x33) << 2;
+	ch1 = (ch1 & 0xAA) >> 1 | (ch1 & 0x55) << 1;
+	return ch1;
 }
 
 
 void ssd1306_fadeout(SSD1306_t * dev)
 {
-	void (*func)(SSD1306_t * dev, int page, int seg, uint8_t * images, int width);
+	void (*func)(SSD1306_t * dev, int page, int seg, const uint8_t * images, int width);
 	if (dev->_address == SPIAddress) {
 		func = spi_display_image;
 	} else {
@@ -589,6 +857,7 @@ void ssd1306_fadeout(SSD1306_t * dev)
 
 	uint8_t image[1];
 	for(int page=0; page<dev->_pages; page++) {
+		ssd1306_lock_region(dev, page, page);
 		image[0] = 0xFF;
 		for(int line=0; line<8; line++) {
 			if (dev->_flip) {
@@ -601,6 +870,7 @@ void ssd1306_fadeout(SSD1306_t * dev)
 				dev->_page[page]._segs[seg] = image[0];
 			}
 		}
+		ssd1306_unlock_region(dev, page, page);
 	}
 }
 
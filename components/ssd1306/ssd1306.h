@@ -1,8 +1,31 @@
 #ifndef MAIN_SSD1306_H_
 #define MAIN_SSD1306_H_
 
+#include <stdarg.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "driver/spi_master.h"
 
+// Mutex of ssd1306_enable_lock. pthread is used when built for host tests.
+#ifdef ESP_PLATFORM
+typedef SemaphoreHandle_t ssd1306_mutex_t;
+#else
+#include <pthread.h>
+typedef struct ssd1306_host_mutex * ssd1306_mutex_t;
+#endif
+
+// Locks of ssd1306_enable_lock, in the order they are taken:
+// 1. Pages of internal buffer, from page 0 up. ssd1306_lock_region takes them for a task drawing a region.
+//    Drawing functions take no lock, so tasks sharing a device draw only inside the region they hold.
+// 2. The device lock. Each transfer and the glyph cache take it, and nothing is taken while it is held.
+// Functions that write internal buffer and send it (ssd1306_display_text, ssd1306_display_image ...)
+// and senders of whole frames (ssd1306_canvas_show, swap chain, pipeline) hold each page they send
+// like ssd1306_lock_region, so call them with no region held or with their pages held.
+// Flushes of internal buffer (ssd1306_show_dirty, ssd1306_show_buffer, ssd1306_show_window, terminal)
+// may be called with a region held. They send the held pages, and the other pages only when no task holds them.
+// Pages held by another task stay dirty for the next flush, so tasks can render regions, then flush together.
+
 // Following definitions are bollowed from 
 // http://robotcantalk.blogspot.com/2015/03/interfacing-arduino-with-ssd1306-driven.html
 
@@ -64,10 +87,26 @@ Usage:
 #define OLED_CMD_HORIZONTAL_RIGHT       0x26
 #define OLED_CMD_HORIZONTAL_LEFT        0x27
 #define OLED_CMD_CONTINUOUS_SCROLL      0x29
+#define OLED_CMD_CONTINUOUS_SCROLL_LEFT 0x2A
+#define OLED_CMD_CONTENT_SCROLL_RIGHT   0x2C    // One column
+#define OLED_CMD_CONTENT_SCROLL_LEFT    0x2D    // One column
 #define OLED_CMD_DEACTIVE_SCROLL        0x2E
 #define OLED_CMD_ACTIVE_SCROLL          0x2F
 #define OLED_CMD_VERTICAL               0xA3
 
+// Zoom Command
+#define OLED_CMD_SET_ZOOM               0xD6    // follow with 0x01 = zoom in, 0x00 = normal
+
+// Maximum number of points for ssd1306_fill_polygon
+#ifndef SSD1306_MAX_POLYGON
+#define SSD1306_MAX_POLYGON 32
+#endif
+
+// Number of expanded glyphs kept for scaled text
+#ifndef SSD1306_GLYPH_CACHE
+#define SSD1306_GLYPH_CACHE 8
+#endif
+
 #define I2CAddress 0x3C
 #define SPIAddress 0xFF
 
@@ -79,12 +118,116 @@ typedef enum {
 	SCROLL_STOP = 5
 } ssd1306_scroll_type_t;
 
+// Frames between steps of hardware scroll. Values are the frame interval codes
+typedef enum {
+	SCROLL_FRAMES_2 = 0x07,
+	SCROLL_FRAMES_3 = 0x04,
+	SCROLL_FRAMES_4 = 0x05,
+	SCROLL_FRAMES_5 = 0x00,
+	SCROLL_FRAMES_25 = 0x06,
+	SCROLL_FRAMES_64 = 0x01,
+	SCROLL_FRAMES_128 = 0x02,
+	SCROLL_FRAMES_256 = 0x03
+} ssd1306_scroll_frames_t;
+
+// Hardware scroll setting
+typedef struct {
+	ssd1306_scroll_type_t horizontal; // SCROLL_RIGHT, SCROLL_LEFT or SCROLL_STOP for none
+	int startPage; // Pages that scroll horizontally
+	int endPage;
+	int start; // Segments that scroll horizontally. Only without vertical scroll
+	int end;
+	int vertical; // Rows per step. Positive scrolls up, negative down, 0 for none
+	int areaTop; // First row of the vertical scroll area
+	int areaRows; // Rows of the vertical scroll area. Other rows do not move
+	ssd1306_scroll_frames_t frames;
+} ssd1306_scroll_config_t;
+
+// How source bits are written to internal buffer
+typedef enum {
+	DRAW_COPY = 0, // Source replaces the area
+	DRAW_OR = 1, // Only set bits of source are drawn
+	DRAW_XOR = 2 // Set bits of source invert the area
+} ssd1306_draw_mode_t;
+
+// Horizontal alignment of text lines in a box
+typedef enum {
+	ALIGN_LEFT = 0,
+	ALIGN_CENTER = 1,
+	ALIGN_RIGHT = 2
+} ssd1306_align_t;
+
+// Where long text lines are broken
+typedef enum {
+	WRAP_NONE = 0, // Only at new line. The rest of long line is cut
+	WRAP_WORD = 1, // At spaces. Words longer than the box are broken anywhere
+	WRAP_CHAR = 2 // At any character
+} ssd1306_wrap_t;
+
+typedef struct {
+	int16_t x;
+	int16_t y;
+} ssd1306_point_t;
+
+// Run of pixels x1,y1 - x2,y2 inclusive, for ssd1306_line_runs
+typedef void (*ssd1306_run_t)(void * ctx, int x1, int y1, int x2, int y2);
+
+// Glyph of proportional font
+typedef struct {
+	uint16_t offset; // Offset of the glyph in bitmap
+	uint8_t width; // Columns of the glyph in bitmap
+	uint8_t advance; // Columns from this glyph to the next glyph
+	int8_t left; // Columns from pen position to the glyph
+} ssd1306_glyph_t;
+
+// Kerning pair of proportional font
+typedef struct {
+	uint16_t first;
+	uint16_t second;
+	int8_t adjust; // Added to advance of first when followed by second
+} ssd1306_kern_t;
+
+// Range of code points in sparse font
+typedef struct {
+	uint16_t first; // First code point of the range
+	uint16_t last; // Last code point of the range
+	uint16_t index; // Index of the glyph of first in glyphs
+} ssd1306_range_t;
+
+// Proportional font.
+// Every glyph is (height + 7) / 8 pages of width bytes in page format, top row is bit 0.
+// Text is UTF-8. Code points are up to U+FFFF.
+// A sparse font has only the glyphs of its ranges, otherwise glyphs are first to last.
+// Use tools/bdf2font.py to make it from BDF font.
+typedef struct {
+	const uint8_t * bitmap;
+	const ssd1306_glyph_t * glyphs;
+	const ssd1306_kern_t * kerning; // Sorted by first and second. NULL when not used
+	uint16_t kerningLen;
+	const ssd1306_range_t * ranges; // Sorted ranges of sparse font. NULL when not used
+	uint16_t rangeLen;
+	uint16_t first; // First code point
+	uint16_t last; // Last code point
+	uint8_t height; // Rows of glyphs
+	uint8_t ascent; // Rows from top to baseline
+} ssd1306_font_t;
+
 typedef struct {
 	bool _valid; // Not using it anymore
 	int _segLen; // Not using it anymore
 	uint8_t _segs[128];
+	int _dirtyStart; // First segment changed since last show. _dirtyStart > _dirtyEnd means clean
+	int _dirtyEnd; // Last segment changed since last show
 } PAGE_t;
 
+// Glyph of font8x8_basic stretched vertically for scaled text
+typedef struct {
+	uint8_t _code;
+	uint8_t _scale; // 0 means not used
+	uint32_t _used; // Least recently used is replaced first
+	uint64_t _columns[8]; // Rows of each column, top row is bit 0
+} GLYPH_t;
+
 typedef struct {
 	int _address;
 	int _width;
@@ -98,23 +241,236 @@ typedef struct {
 	int _scDirection;
 	PAGE_t _page[8];
 	bool _flip;
+	int _zoomStart; // First page shown by hardware zoom. -1 means not zoomed
+	int _scrollStart; // Pages moved by hardware scroll. _scrollStart > _scrollEnd means not scrolling
+	int _scrollEnd;
+	int _cursorX; // Position of the next character of ssd1306_printf
+	int _cursorY;
+	int _cursorLeft; // xpos of ssd1306_set_cursor. New line goes back here
+	GLYPH_t _glyph[SSD1306_GLYPH_CACHE];
+	uint32_t _glyphTick;
+	ssd1306_mutex_t _lock; // Bus and glyph cache. NULL means no locking
+	ssd1306_mutex_t _pageLock[8]; // Pages of internal buffer. Drawing does not take them
 } SSD1306_t;
 
+// Shape of the ends of segments
+typedef enum {
+	SEGMENT_SEVEN = 0, // Pointed ends like LED seven segment display
+	SEGMENT_ROUND = 1 // Round ends
+} ssd1306_segment_style_t;
+
+// Size and style of large seven segment characters
+typedef struct {
+	int width; // Width of a digit
+	int height; // Height of a digit. At least 4 times thickness
+	int thickness; // Thickness of a segment. Odd numbers look best
+	int spacing; // Columns between characters
+	ssd1306_segment_style_t style;
+} ssd1306_segment_t;
+
+#ifndef SSD1306_ODOMETER_DIGITS
+#define SSD1306_ODOMETER_DIGITS 8
+#endif
+
+// Rolling counter. Each digit rolls up in its own column window.
+typedef struct {
+	SSD1306_t * _dev;
+	const uint8_t * _glyphs; // Page format images of 0 to 9
+	int _xpos;
+	int _ypos;
+	int _width; // Width of a digit
+	int _height; // Height of a digit. Up to 64
+	int _spacing; // Columns between digits
+	int _digits;
+	bool _invert;
+	uint8_t _value[SSD1306_ODOMETER_DIGITS]; // Digit at the top of the window
+	uint8_t _target[SSD1306_ODOMETER_DIGITS]; // Digit to stop at
+	int _offset[SSD1306_ODOMETER_DIGITS]; // Rows rolled from _value to the next digit
+} ssd1306_odometer_t;
+
+// Console on the whole panel. Each text line is one page.
+// Pages are used as a ring and scrolled by display start line, so a new line costs one page write.
+typedef struct {
+	SSD1306_t * _dev;
+	const ssd1306_font_t * _font; // NULL means 8x8 font
+	bool _invert;
+	int _top; // Page shown at the top of the panel
+	int _row; // Line of the cursor from the top
+	int _col; // xpos of the cursor
+	uint32_t _prev; // Previous character for kerning
+	bool _scrolled; // Display start line is not sent yet
+} ssd1306_terminal_t;
+
+// Page format surface of any size. The panel shows the viewport at _x, _y.
+typedef struct {
+	uint8_t * _buffer; // (height + 7) / 8 pages of width bytes, top row is bit 0. Not flipped
+	int _width;
+	int _height;
+	int _pages;
+	int _x; // Canvas column at the left of the panel
+	int _y; // Canvas row at the top of the panel
+} ssd1306_canvas_t;
+
+// Modes of ssd1306_swap_init
+#define SSD1306_SWAP_SHARED 2 // Two slots. A frame presented while the other slot is sent waits in the free one
+#define SSD1306_SWAP_LATEST 3 // Three slots. A frame not sent yet is replaced by the latest one
+
+// Swap chain between a drawing task and a sending task.
+// Frames are handed over by atomic exchange of the slot index or state, so neither side waits for the other.
+// _frame always has 3 slots, so the chain is one type for both modes and needs no heap.
+// SSD1306_SWAP_SHARED uses slots 0 and 1 only.
+typedef struct {
+	SSD1306_t * _dev;
+	uint8_t _frame[3][8][128];
+	int _buffers; // SSD1306_SWAP_SHARED or SSD1306_SWAP_LATEST
+	int _back; // Slot written by ssd1306_swap_present. Only with SSD1306_SWAP_LATEST
+	int _front; // Slot sent by ssd1306_swap_flush
+	volatile uint32_t _pending; // Slot of the latest frame and its state flags
+	volatile uint32_t _dropped; // Frames replaced by a later frame or skipped before sent
+} ssd1306_swap_t;
+
+// Display list. Drawing calls are recorded into a buffer of the caller and replayed later.
+// Only fills and blits are stored. Text and lines are turned into them when recorded.
+typedef struct {
+	uint8_t * _buffer;
+	int _size;
+	int _used;
+	int _last; // Offset of the last command. -1 means empty
+	bool _overflow; // A command did not fit
+	int _x1, _y1, _x2, _y2; // Area drawn by the list. _x1 > _x2 means empty
+} ssd1306_list_t;
+
+// Frames queued between ssd1306_pipeline_submit and the flush task
+#define SSD1306_PIPELINE_FRAMES 4
+
+// Time spent in each stage of the pipeline, in microseconds since ssd1306_pipeline_start.
+// flush task mostly idle: render-bound. submit waiting or dropping: bus-bound.
+typedef struct {
+	uint32_t frames; // Frames sent by the flush task
+	uint32_t dropped; // Frames not queued because the queue was full or the pipeline stopped
+	uint32_t pages; // Pages sent. Pages same as the last frame are not sent
+	int64_t renderTime; // From ssd1306_pipeline_begin to ssd1306_pipeline_submit
+	int64_t submitTime; // Copying frames to the queue and waiting for a free slot
+	int64_t flushTime; // Sending frames
+	int64_t idleTime; // Flush task waiting for a frame
+} ssd1306_pipeline_stats_t;
+
+// Flush task on its own core fed by a single-producer, single-consumer queue of frames.
+// The drawing task owns _head and the flush task owns _tail, so the queue needs no lock.
+typedef struct {
+	SSD1306_t * _dev;
+	uint8_t _frame[SSD1306_PIPELINE_FRAMES][8][128];
+	uint8_t _shown[8][128]; // Last frame sent
+	bool _shownValid;
+	volatile uint32_t _head; // Frames submitted
+	volatile uint32_t _tail; // Frames sent
+	volatile bool _running;
+	TaskHandle_t _task; // Flush task
+	SemaphoreHandle_t _slotFree; // Given by the flush task for each frame sent
+	StaticSemaphore_t _slotFreeBuffer;
+	int64_t _renderStart;
+	ssd1306_pipeline_stats_t _stats; // Written by both tasks under _statsLock
+	portMUX_TYPE _statsLock;
+} ssd1306_pipeline_t;
+
+// Scrolling ticker in a band of pages. Text is rendered one column at a time as it enters.
+typedef struct {
+	SSD1306_t * _dev;
+	const ssd1306_font_t * _font; // NULL means 8x8 font
+	char * _text;
+	int _textLen;
+	char * _next; // Text shown after the current one ends. NULL when not set
+	int _nextLen;
+	int _page; // First page of the band
+	int _pages; // Pages of the band
+	int _start; // Segments of the window
+	int _end;
+	int _gap; // Blank columns between the end and the start of text
+	bool _invert;
+	bool _hardware; // Use one column content scroll
+	int _pos; // Byte of text after the current character
+	uint32_t _code; // Current character
+	bool _inGap; // Current cell is the gap
+	int _column; // Next column of the current cell
+	int _advance; // Columns of the current cell
+} ssd1306_ticker_t;
+
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
 void ssd1306_init(SSD1306_t * dev, int width, int height);
+bool ssd1306_enable_lock(SSD1306_t * dev);
+void ssd1306_disable_lock(SSD1306_t * dev);
+void ssd1306_lock(SSD1306_t * dev);
+void ssd1306_unlock(SSD1306_t * dev);
+void ssd1306_lock_region(SSD1306_t * dev, int startPage, int endPage);
+void ssd1306_unlock_region(SSD1306_t * dev, int startPage, int endPage);
 int ssd1306_get_width(SSD1306_t * dev);
 int ssd1306_get_height(SSD1306_t * dev);
 int ssd1306_get_pages(SSD1306_t * dev);
 void ssd1306_show_buffer(SSD1306_t * dev);
 void ssd1306_set_buffer(SSD1306_t * dev, uint8_t * buffer);
 void ssd1306_get_buffer(SSD1306_t * dev, uint8_t * buffer);
-void ssd1306_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width);
+void ssd1306_mark_dirty(SSD1306_t * dev, int page, int start, int end);
+void ssd1306_show_dirty(SSD1306_t * dev);
+void ssd1306_show_window(SSD1306_t * dev, int startPage, int endPage, int start, int end);
+void ssd1306_display_image(SSD1306_t * dev, int page, int seg, const uint8_t * images, int width);
 void ssd1306_display_text(SSD1306_t * dev, int page, char * text, int text_len, bool invert);
+void ssd1306_buffer_text(SSD1306_t * dev, int page, char * text, int text_len, bool invert);
 void ssd1306_display_text_x3(SSD1306_t * dev, int page, char * text, int text_len, bool invert);
+void ssd1306_display_text_scaled(SSD1306_t * dev, int page, char * text, int text_len, int xscale, int yscale, bool invert);
+void ssd1306_buffer_text_scaled(SSD1306_t * dev, int page, char * text, int text_len, int xscale, int yscale, bool invert);
+void ssd1306_draw_text(SSD1306_t * dev, int xpos, int ypos, char * text, int text_len, bool invert, ssd1306_draw_mode_t mode);
+int ssd1306_draw_string(SSD1306_t * dev, const ssd1306_font_t * font, int xpos, int ypos, char * text, int text_len, bool invert, ssd1306_draw_mode_t mode);
+int ssd1306_string_width(const ssd1306_font_t * font, char * text, int text_len);
+void ssd1306_set_cursor(SSD1306_t * dev, int xpos, int ypos);
+int ssd1306_printf(SSD1306_t * dev, const ssd1306_font_t * font, bool invert, const char * format, ...) __attribute__((format(printf, 4, 5)));
+int ssd1306_vprintf(SSD1306_t * dev, const ssd1306_font_t * font, bool invert, const char * format, va_list args);
+void ssd1306_terminal_init(SSD1306_t * dev, ssd1306_terminal_t * term, const ssd1306_font_t * font, bool invert);
+void ssd1306_terminal_clear(ssd1306_terminal_t * term);
+void ssd1306_terminal_deinit(ssd1306_terminal_t * term);
+void ssd1306_terminal_write(ssd1306_terminal_t * term, char * text, int text_len);
+int ssd1306_terminal_printf(ssd1306_terminal_t * term, const char * format, ...) __attribute__((format(printf, 2, 3)));
+void ssd1306_canvas_init(ssd1306_canvas_t * canvas, uint8_t * buffer, int width, int height);
+void ssd1306_canvas_clear(ssd1306_canvas_t * canvas, bool invert);
+void ssd1306_canvas_set_pixel(ssd1306_canvas_t * canvas, int xpos, int ypos, bool invert);
+void ssd1306_canvas_blit(ssd1306_canvas_t * canvas, int xpos, int ypos, const uint8_t * images, int width, int height, bool invert, ssd1306_draw_mode_t mode);
+void ssd1306_canvas_bitmaps(ssd1306_canvas_t * canvas, int xpos, int ypos, const uint8_t * bitmap, int width, int height, bool invert);
+void ssd1306_canvas_fill_rect(ssd1306_canvas_t * canvas, int xpos, int ypos, int width, int height, bool invert);
+void ssd1306_canvas_pan(ssd1306_canvas_t * canvas, int xpos, int ypos);
+void ssd1306_canvas_show(SSD1306_t * dev, const ssd1306_canvas_t * canvas);
+void ssd1306_list_init(ssd1306_list_t * list, uint8_t * buffer, int size);
+void ssd1306_list_clear(ssd1306_list_t * list);
+bool ssd1306_list_fill_rect(ssd1306_list_t * list, int xpos, int ypos, int width, int height, bool invert);
+bool ssd1306_list_line(ssd1306_list_t * list, int x1, int y1, int x2, int y2, bool invert);
+bool ssd1306_list_blit(ssd1306_list_t * list, int xpos, int ypos, const uint8_t * images, int width, int height, bool invert, ssd1306_draw_mode_t mode);
+bool ssd1306_list_text(ssd1306_list_t * list, int xpos, int ypos, char * text, int text_len, bool invert, ssd1306_draw_mode_t mode);
+bool ssd1306_list_string(ssd1306_list_t * list, const ssd1306_font_t * font, int xpos, int ypos, char * text, int text_len, bool invert, ssd1306_draw_mode_t mode);
+bool ssd1306_list_bounds(const ssd1306_list_t * list, int * xpos, int * ypos, int * width, int * height);
+bool ssd1306_list_equal(const ssd1306_list_t * list1, const ssd1306_list_t * list2);
+void ssd1306_list_replay(SSD1306_t * dev, const ssd1306_list_t * list, int xpos, int ypos);
+void ssd1306_list_replay_canvas(ssd1306_canvas_t * canvas, const ssd1306_list_t * list, int xpos, int ypos);
+void ssd1306_swap_init(SSD1306_t * dev, ssd1306_swap_t * swap, int buffers);
+bool ssd1306_swap_present(ssd1306_swap_t * swap);
+bool ssd1306_swap_flush(ssd1306_swap_t * swap);
+bool ssd1306_pipeline_start(SSD1306_t * dev, ssd1306_pipeline_t * pipe, int core, UBaseType_t priority);
+void ssd1306_pipeline_stop(ssd1306_pipeline_t * pipe);
+void ssd1306_pipeline_begin(ssd1306_pipeline_t * pipe);
+bool ssd1306_pipeline_submit(ssd1306_pipeline_t * pipe, bool wait);
+void ssd1306_pipeline_stats(ssd1306_pipeline_t * pipe, ssd1306_pipeline_stats_t * stats);
+void ssd1306_ticker_init(SSD1306_t * dev, ssd1306_ticker_t * ticker, const ssd1306_font_t * font, int page, int start, int end, char * text, int text_len, int gap, bool invert, bool hardware);
+void ssd1306_ticker_set_text(ssd1306_ticker_t * ticker, char * text, int text_len);
+void ssd1306_ticker_tick(ssd1306_ticker_t * ticker, int columns);
+int ssd1306_measure_text(const ssd1306_font_t * font, int width, char * text, int text_len, ssd1306_wrap_t wrap, int * text_width);
+int ssd1306_draw_text_box(SSD1306_t * dev, const ssd1306_font_t * font, int xpos, int ypos, int width, int height, char * text, int text_len, ssd1306_align_t align, ssd1306_wrap_t wrap, bool invert);
+int ssd1306_draw_segments(SSD1306_t * dev, const ssd1306_segment_t * segment, int xpos, int ypos, char * text, char * old, int text_len, bool invert);
+int ssd1306_segments_width(const ssd1306_segment_t * segment, char * text, int text_len);
+void ssd1306_segments_image(const ssd1306_segment_t * segment, char ch, uint8_t * image);
+void ssd1306_odometer_init(SSD1306_t * dev, ssd1306_odometer_t * odometer, const uint8_t * glyphs, int width, int height, int spacing, int xpos, int ypos, int digits, bool invert);
+void ssd1306_odometer_set(ssd1306_odometer_t * odometer, uint32_t value);
+bool ssd1306_odometer_step(ssd1306_odometer_t * odometer, int rows);
 void ssd1306_clear_screen(SSD1306_t * dev, bool invert);
 void ssd1306_clear_line(SSD1306_t * dev, int page, bool invert);
 void ssd1306_contrast(SSD1306_t * dev, int contrast);
@@ -122,10 +478,40 @@ void ssd1306_software_scroll(SSD1306_t * dev, int start, int end);
 void ssd1306_scroll_text(SSD1306_t * dev, char * text, int text_len, bool invert);
 void ssd1306_scroll_clear(SSD1306_t * dev);
 void ssd1306_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll);
+void ssd1306_hardware_scroll_config(SSD1306_t * dev, const ssd1306_scroll_config_t * config);
+void ssd1306_content_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int startPage, int endPage, int start, int end);
+void ssd1306_hardware_zoom(SSD1306_t * dev, int start);
+void ssd1306_display_start_line(SSD1306_t * dev, int line);
+void ssd1306_display_text_zoom(SSD1306_t * dev, int line, char * text, int text_len, int xscale, bool invert);
 void ssd1306_wrap_arround(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int start, int end, int8_t delay);
+void ssd1306_wrap_arround_window(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int startPage, int endPage, int start, int end, int step, int8_t delay);
 void ssd1306_bitmaps(SSD1306_t * dev, int xpos, int ypos, uint8_t * bitmap, int width, int height, bool invert);
 void _ssd1306_pixel(SSD1306_t * dev, int xpos, int ypos, bool invert);
 void _ssd1306_line(SSD1306_t * dev, int x1, int y1, int x2, int y2,  bool invert);
+void ssd1306_blit(SSD1306_t * dev, int xpos, int ypos, const uint8_t * images, int width, int height, bool invert, ssd1306_draw_mode_t mode);
+void ssd1306_set_pixel(SSD1306_t * dev, int xpos, int ypos, bool invert);
+void ssd1306_toggle_pixel(SSD1306_t * dev, int xpos, int ypos);
+bool ssd1306_get_pixel(SSD1306_t * dev, int xpos, int ypos);
+void ssd1306_plot_points(SSD1306_t * dev, const ssd1306_point_t * points, int count, bool invert);
+void ssd1306_line(SSD1306_t * dev, int x1, int y1, int x2, int y2, bool invert);
+void ssd1306_line_runs(int x1, int y1, int x2, int y2, ssd1306_run_t run, void * ctx);
+void ssd1306_hline(SSD1306_t * dev, int xpos, int ypos, int width, bool invert);
+void ssd1306_vline(SSD1306_t * dev, int xpos, int ypos, int height, bool invert);
+void ssd1306_rect(SSD1306_t * dev, int xpos, int ypos, int width, int height, bool invert);
+void ssd1306_fill_rect(SSD1306_t * dev, int xpos, int ypos, int width, int height, bool invert);
+void ssd1306_invert_rect(SSD1306_t * dev, int xpos, int ypos, int width, int height);
+void ssd1306_circle(SSD1306_t * dev, int x0, int y0, int r, bool invert);
+void ssd1306_fill_circle(SSD1306_t * dev, int x0, int y0, int r, bool invert);
+void ssd1306_ellipse(SSD1306_t * dev, int x0, int y0, int rx, int ry, bool invert);
+void ssd1306_fill_ellipse(SSD1306_t * dev, int x0, int y0, int rx, int ry, bool invert);
+void ssd1306_round_rect(SSD1306_t * dev, int xpos, int ypos, int width, int height, int r, bool invert);
+void ssd1306_fill_round_rect(SSD1306_t * dev, int xpos, int ypos, int width, int height, int r, bool invert);
+void ssd1306_arc(SSD1306_t * dev, int x0, int y0, int r, int start, int end, bool invert);
+void ssd1306_fill_arc(SSD1306_t * dev, int x0, int y0, int r, int start, int end, bool invert);
+void ssd1306_polygon(SSD1306_t * dev, const ssd1306_point_t * points, int count, bool invert);
+void ssd1306_fill_polygon(SSD1306_t * dev, const ssd1306_point_t * points, int count, bool invert);
+void ssd1306_triangle(SSD1306_t * dev, int x1, int y1, int x2, int y2, int x3, int y3, bool invert);
+void ssd1306_fill_triangle(SSD1306_t * dev, int x1, int y1, int x2, int y2, int x3, int y3, bool invert);
 void ssd1306_invert(uint8_t *buf, size_t blen);
 void ssd1306_flip(uint8_t *buf, size_t blen);
 uint8_t ssd1306_copy_bit(uint8_t src, int srcBits, uint8_t dst, int dstBits);
@@ -136,18 +522,24 @@ void ssd1306_dump_page(SSD1306_t * dev, int page, int seg);
 
 void i2c_master_init(SSD1306_t * dev, int16_t sda, int16_t scl, int16_t reset);
 void i2c_init(SSD1306_t * dev, int width, int height);
-void i2c_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width);
+void i2c_display_image(SSD1306_t * dev, int page, int seg, const uint8_t * images, int width);
 void i2c_contrast(SSD1306_t * dev, int contrast);
-void i2c_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll);
+void i2c_hardware_scroll(SSD1306_t * dev, const ssd1306_scroll_config_t * config);
+void i2c_content_scroll(SSD1306_t * dev, const ssd1306_scroll_config_t * config);
+void i2c_hardware_zoom(SSD1306_t * dev, int line, bool enable);
+void i2c_display_start_line(SSD1306_t * dev, int line);
 
 void spi_master_init(SSD1306_t * dev, int16_t GPIO_MOSI, int16_t GPIO_SCLK, int16_t GPIO_CS, int16_t GPIO_DC, int16_t GPIO_RESET);
 bool spi_master_write_byte(spi_device_handle_t SPIHandle, const uint8_t* Data, size_t DataLength );
 bool spi_master_write_command(SSD1306_t * dev, uint8_t Command );
 bool spi_master_write_data(SSD1306_t * dev, const uint8_t* Data, size_t DataLength );
 void spi_init(SSD1306_t * dev, int width, int height);
-void spi_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width);
+void spi_display_image(SSD1306_t * dev, int page, int seg, const uint8_t * images, int width);
 void spi_contrast(SSD1306_t * dev, int contrast);
-void spi_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll);
+void spi_hardware_scroll(SSD1306_t * dev, const ssd1306_scroll_config_t * config);
+void spi_content_scroll(SSD1306_t * dev, const ssd1306_scroll_config_t * config);
+void spi_hardware_zoom(SSD1306_t * dev, int line, bool enable);
+void spi_display_start_line(SSD1306_t * dev, int line);
 
 #ifdef __cplusplus
 }
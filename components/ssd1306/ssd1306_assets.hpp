@@ -0,0 +1,107 @@
+/*
+ * ssd1306_assets.hpp
+ *
+ * Compile time conversion of fonts and icons to page format for C++.
+ * Assets are written row by row in source and become const tables in flash.
+ * No transposition or bit reversal is left for run time.
+ *
+ *	// 8x8 icon from ASCII art. '.' and ' ' are off, others are on.
+ *	constexpr auto heart = ssd1306::image<8, 8>(
+ *		".##..##."
+ *		"########"
+ *		"########"
+ *		"########"
+ *		".######."
+ *		"..####.."
+ *		"...##..."
+ *		"........");
+ *	ssd1306_blit(&dev, 10, 20, heart.data(), 8, 8, false, DRAW_OR);
+ *
+ *	// Same table as font8x8_basic_tr from the original row-major font8x8_basic
+ *	constexpr auto font_tr = ssd1306::transpose(font8x8_basic);
+ *
+ * ssd1306_blit and the drawing functions flip the data themselves on a flipped panel,
+ * so give them NORMAL data. ssd1306_display_image sends the bytes as they are, so give it
+ * the FLIPPED variant on a flipped panel and the INVERTED variant for inverted text.
+ *
+ *	constexpr auto digits = ssd1306::transpose(digits_rows);
+ *	constexpr auto digits_flipped = ssd1306::transpose(digits_rows, ssd1306::FLIPPED);
+ *	ssd1306_display_image(&dev, page, seg, dev._flip ? digits_flipped[n].data() : digits[n].data(), 8);
+ *
+ * Needs C++17.
+ */
+
+#ifndef MAIN_SSD1306_ASSETS_HPP_
+#define MAIN_SSD1306_ASSETS_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ssd1306 {
+
+// Variants of page format data. FLIPPED | INVERTED makes both.
+enum variant : unsigned {
+	NORMAL = 0,
+	FLIPPED = 1, // Bits of each byte reversed like ssd1306_flip, for flipped panel
+	INVERTED = 2 // Bits of each byte inverted like ssd1306_invert
+};
+
+constexpr uint8_t rotate_byte(uint8_t ch)
+{
+	ch = (uint8_t)((ch & 0xF0) >> 4 | (ch & 0x0F) << 4);
+	ch = (uint8_t)((ch & 0xCC) >> 2 | (ch & 0x33) << 2);
+	ch = (uint8_t)((ch & 0xAA) >> 1 | (ch & 0x55) << 1);
+	return ch;
+}
+
+constexpr uint8_t apply_variant(uint8_t ch, unsigned v)
+{
+	if (v & INVERTED) ch = (uint8_t)~ch;
+	if (v & FLIPPED) ch = rotate_byte(ch);
+	return ch;
+}
+
+// Page format image. (H + 7) / 8 pages of W bytes, top row is bit 0.
+// Same layout as images of ssd1306_blit and ssd1306_display_image.
+template <std::size_t W, std::size_t H>
+using image_t = std::array<uint8_t, W * ((H + 7) / 8)>;
+
+// Image from ASCII art of H rows of W characters. '.' and ' ' are off, others are on.
+template <std::size_t W, std::size_t H>
+constexpr image_t<W, H> image(const char (&art)[W * H + 1], unsigned v = NORMAL)
+{
+	image_t<W, H> out{};
+	for (std::size_t y = 0; y < H; y++) {
+		for (std::size_t x = 0; x < W; x++) {
+			char c = art[y * W + x];
+			if (c != '.' && c != ' ') out[(y / 8) * W + x] |= (uint8_t)(1u << (y % 8));
+		}
+	}
+	for (std::size_t i = 0; i < out.size(); i++) out[i] = apply_variant(out[i], v);
+	return out;
+}
+
+// Page format glyphs from a row-major font of N glyphs of H rows.
+// Each row is one byte of W pixels. The leftmost pixel is bit 0 like font8x8_basic,
+// or bit 7 when msb_first is true like most other 8 pixel wide fonts.
+template <std::size_t W = 8, std::size_t N, std::size_t H>
+constexpr std::array<image_t<W, H>, N> transpose(const uint8_t (&rows)[N][H], unsigned v = NORMAL, bool msb_first = false)
+{
+	static_assert(W >= 1 && W <= 8, "rows are one byte");
+	std::array<image_t<W, H>, N> out{};
+	for (std::size_t n = 0; n < N; n++) {
+		for (std::size_t y = 0; y < H; y++) {
+			for (std::size_t x = 0; x < W; x++) {
+				unsigned bit = msb_first ? (7 - x) : x;
+				if (rows[n][y] & (1u << bit)) out[n][(y / 8) * W + x] |= (uint8_t)(1u << (y % 8));
+			}
+		}
+		for (std::size_t i = 0; i < out[n].size(); i++) out[n][i] = apply_variant(out[n][i], v);
+	}
+	return out;
+}
+
+} // namespace ssd1306
+
+#endif /* MAIN_SSD1306_ASSETS_HPP_ */
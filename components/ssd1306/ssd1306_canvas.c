@@ -0,0 +1,136 @@
+#include <string.h>
+
+#include "esp_log.h"
+
+#include "ssd1306.h"
+#include "ssd1306_private.h"
+
+#define TAG "SSD1306"
+
+// Use buffer of (height + 7) / 8 * width bytes as a canvas. buffer is used as it is.
+// The viewport starts at 0, 0.
+void ssd1306_canvas_init(ssd1306_canvas_t * canvas, uint8_t * buffer, int width, int height)
+{
+	canvas->_buffer = buffer;
+	canvas->_width = width;
+	canvas->_height = height;
+	canvas->_pages = (height + 7) / 8;
+	canvas->_x = 0;
+	canvas->_y = 0;
+}
+
+void ssd1306_canvas_clear(ssd1306_canvas_t * canvas, bool invert)
+{
+	memset(canvas->_buffer, invert ? 0xFF : 0x00, canvas->_pages * canvas->_width);
+}
+
+// Set pixel to canvas. Not show it.
+void ssd1306_canvas_set_pixel(ssd1306_canvas_t * canvas, int xpos, int ypos, bool invert)
+{
+	if ((unsigned)xpos >= (unsigned)canvas->_width || (unsigned)ypos >= (unsigned)canvas->_height) return;
+	uint8_t * seg = &canvas->_buffer[(ypos / 8) * canvas->_width + xpos];
+	if (invert) {
+		*seg &= ~(1 << (ypos % 8));
+	} else {
+		*seg |= (1 << (ypos % 8));
+	}
+}
+
+// Canvas as a surface. Pages are width bytes apart and never flipped.
+static inline ssd1306_surface_t _canvas_surface(ssd1306_canvas_t * canvas)
+{
+	ssd1306_surface_t surface = {
+		._base = canvas->_buffer,
+		._stride = canvas->_width,
+		._pages = canvas->_pages,
+		._width = canvas->_width,
+		._height = canvas->_height,
+		._flip = false,
+		._dev = NULL,
+	};
+	return surface;
+}
+
+// Set page format image to canvas at any position like ssd1306_blit. Not show it.
+void ssd1306_canvas_blit(ssd1306_canvas_t * canvas, int xpos, int ypos, const uint8_t * images, int width, int height, bool invert, ssd1306_draw_mode_t mode)
+{
+	ssd1306_surface_t surface = _canvas_surface(canvas);
+	_ssd1306_surface_blit(&surface, xpos, ypos, images, width, height, invert, mode);
+}
+
+// Set filled rectangle to canvas. Not show it.
+void ssd1306_canvas_fill_rect(ssd1306_canvas_t * canvas, int xpos, int ypos, int width, int height, bool invert)
+{
+	if (width <= 0 || height <= 0) return;
+	ssd1306_surface_t surface = _canvas_surface(canvas);
+	_ssd1306_surface_span(&surface, xpos, ypos, xpos + width - 1, ypos + height - 1, invert ? SPAN_CLEAR : SPAN_SET);
+}
+
+// Set bitmap of ssd1306_bitmaps format to canvas. Not show it.
+// bitmap is row by row, width / 8 bytes per row, and the leftmost pixel is bit 7.
+void ssd1306_canvas_bitmaps(ssd1306_canvas_t * canvas, int xpos, int ypos, const uint8_t * bitmap, int width, int height, bool invert)
+{
+	if ( (width % 8) != 0) {
+		ESP_LOGE(TAG, "width must be a multiple of 8");
+		return;
+	}
+	int _width = width / 8;
+	for (int yy=0; yy<height; yy++) {
+		for (int xx=0; xx<width; xx++) {
+			bool on = (bitmap[yy * _width + xx / 8] >> (7 - (xx % 8))) & 1;
+			if (on != invert) {
+				ssd1306_canvas_set_pixel(canvas, xpos + xx, ypos + yy, false);
+			} else {
+				ssd1306_canvas_set_pixel(canvas, xpos + xx, ypos + yy, true);
+			}
+		}
+	}
+}
+
+// Move the viewport. The panel shows the canvas from xpos, ypos with ssd1306_canvas_show.
+// Parts of the viewport outside of the canvas are blank.
+void ssd1306_canvas_pan(ssd1306_canvas_t * canvas, int xpos, int ypos)
+{
+	canvas->_x = xpos;
+	canvas->_y = ypos;
+}
+
+// Show the viewport of the canvas on the whole panel.
+// Pages are sent straight from the canvas when the viewport is on a page boundary.
+// Otherwise each page is built from two canvas pages into one line on the stack.
+// Internal buffer is not used or changed.
+void ssd1306_canvas_show(SSD1306_t * dev, const ssd1306_canvas_t * canvas)
+{
+	uint8_t line[128];
+	int x = canvas->_x;
+	for (int page=0; page<dev->_pages; page++) {
+		int top = canvas->_y + page * 8;
+		int srcPage = (top >= 0) ? (top / 8) : -((7 - top) / 8);
+		int shift = top - srcPage * 8;
+		const uint8_t * images = line;
+		if (shift == 0 && !dev->_flip && srcPage >= 0 && srcPage < canvas->_pages
+			&& x >= 0 && x + dev->_width <= canvas->_width) {
+			images = &canvas->_buffer[srcPage * canvas->_width + x];
+		} else {
+			bool lower = (srcPage >= 0 && srcPage < canvas->_pages);
+			bool upper = (shift != 0 && srcPage + 1 >= 0 && srcPage + 1 < canvas->_pages);
+			for (int seg=0; seg<dev->_width; seg++) {
+				int col = x + seg;
+				uint8_t wk = 0;
+				if (col >= 0 && col < canvas->_width) {
+					if (lower) wk = canvas->_buffer[srcPage * canvas->_width + col] >> shift;
+					if (upper) wk |= canvas->_buffer[(srcPage + 1) * canvas->_width + col] << (8 - shift);
+				}
+				if (dev->_flip) wk = ssd1306_rotate_byte(wk);
+				line[seg] = wk;
+			}
+		}
+		ssd1306_lock_region(dev, page, page);
+		if (dev->_address == SPIAddress) {
+			spi_display_image(dev, page, 0, images, dev->_width);
+		} else {
+			i2c_display_image(dev, page, 0, images, dev->_width);
+		}
+		ssd1306_unlock_region(dev, page, page);
+	}
+}
@@ -0,0 +1,821 @@
+#include <string.h>
+#include <stdlib.h>
+
+#include "esp_log.h"
+
+#include "ssd1306.h"
+#include "ssd1306_private.h"
+
+#define TAG "SSD1306"
+
+// Bit mask of the rows top to bottom(0 to 7) in one page.
+// When flip is enabled, the bits of each byte are stored reversed.
+static inline uint8_t _span_mask(bool flip, int top, int bottom)
+{
+	if (flip) {
+		return (0xFF >> top) & (0xFF << (7 - bottom));
+	}
+	return (0xFF << top) & (0xFF >> (7 - bottom));
+}
+
+// Internal buffer as a surface. Pages are PAGE_t apart, and changes are marked dirty.
+static inline ssd1306_surface_t _device_surface(SSD1306_t * dev)
+{
+	ssd1306_surface_t surface = {
+		._base = dev->_page[0]._segs,
+		._stride = sizeof(PAGE_t),
+		._pages = dev->_pages,
+		._width = dev->_width,
+		._height = dev->_height,
+		._flip = dev->_flip,
+		._dev = dev,
+	};
+	return surface;
+}
+
+// Apply op to the area x1,y1 - x2,y2 of surface.
+// Coordinates are inclusive and clipped to the surface.
+// Each column of each page is updated by one byte operation.
+void _ssd1306_surface_span(const ssd1306_surface_t * surface, int x1, int y1, int x2, int y2, span_op_t op)
+{
+	if (x1 < 0) x1 = 0;
+	if (y1 < 0) y1 = 0;
+	if (x2 >= surface->_width) x2 = surface->_width - 1;
+	if (y2 >= surface->_height) y2 = surface->_height - 1;
+	if (x1 > x2 || y1 > y2) return;
+
+	int first = y1 / 8;
+	int last = y2 / 8;
+	for (int page=first; page<=last; page++) {
+		int top = (page == first) ? (y1 % 8) : 0;
+		int bottom = (page == last) ? (y2 % 8) : 7;
+		uint8_t mask = _span_mask(surface->_flip, top, bottom);
+		uint8_t * segs = &surface->_base[page * surface->_stride];
+		if (op == SPAN_SET) {
+			if (mask == 0xFF) {
+				memset(&segs[x1], 0xFF, x2 - x1 + 1);
+			} else {
+				for (int seg=x1; seg<=x2; seg++) segs[seg] |= mask;
+			}
+		} else if (op == SPAN_CLEAR) {
+			if (mask == 0xFF) {
+				memset(&segs[x1], 0x00, x2 - x1 + 1);
+			} else {
+				for (int seg=x1; seg<=x2; seg++) segs[seg] &= ~mask;
+			}
+		} else {
+			for (int seg=x1; seg<=x2; seg++) segs[seg] ^= mask;
+		}
+		if (surface->_dev != NULL) ssd1306_mark_dirty(surface->_dev, page, x1, x2);
+	}
+}
+
+// Apply op to the area x1,y1 - x2,y2 of internal buffer.
+static void _ssd1306_span(SSD1306_t * dev, int x1, int y1, int x2, int y2, span_op_t op)
+{
+	ssd1306_surface_t surface = _device_surface(dev);
+	_ssd1306_surface_span(&surface, x1, y1, x2, y2, op);
+}
+
+// Write bits under mask to one byte of a surface.
+// bits and mask are in panel order, top row is bit 0.
+static inline bool _blit_byte(bool flip, uint8_t * seg, uint8_t bits, uint8_t mask, ssd1306_draw_mode_t mode)
+{
+	if (flip) {
+		bits = ssd1306_rotate_byte(bits);
+		mask = ssd1306_rotate_byte(mask);
+	}
+	bits &= mask;
+	uint8_t old = *seg;
+	if (mode == DRAW_OR) {
+		*seg |= bits;
+	} else if (mode == DRAW_XOR) {
+		*seg ^= bits;
+	} else {
+		*seg = (*seg & ~mask) | bits;
+	}
+	return *seg != old;
+}
+
+// Set page format image to surface at any position.
+// images is width bytes per page, top row is bit 0. It is (height + 7) / 8 pages.
+// Each source byte is shifted across two pages, so ypos need not be a multiple of 8.
+// Only segments actually changed are marked dirty, so redrawing the same image costs no transfer.
+void _ssd1306_surface_blit(const ssd1306_surface_t * surface, int xpos, int ypos, const uint8_t * images, int width, int height, bool invert, ssd1306_draw_mode_t mode)
+{
+	if (width <= 0 || height <= 0) return;
+	int x1 = (xpos < 0) ? 0 : xpos;
+	int x2 = xpos + width - 1;
+	if (x2 >= surface->_width) x2 = surface->_width - 1;
+	if (x1 > x2) return;
+
+	bool flip = surface->_flip;
+	int srcPages = (height + 7) / 8;
+	for (int srcPage=0; srcPage<srcPages; srcPage++) {
+		int rows = height - srcPage * 8;
+		uint8_t valid = (rows >= 8) ? 0xFF : (0xFF >> (8 - rows));
+		int top = ypos + srcPage * 8;
+		int page = (top >= 0) ? (top / 8) : -((7 - top) / 8);
+		int shift = top - page * 8;
+		bool lower = (page >= 0 && page < surface->_pages);
+		bool upper = (shift != 0 && page + 1 >= 0 && page + 1 < surface->_pages);
+		if (!lower && !upper) continue;
+		uint8_t * lowerSegs = lower ? &surface->_base[page * surface->_stride] : NULL;
+		uint8_t * upperSegs = upper ? &surface->_base[(page + 1) * surface->_stride] : NULL;
+		int lowerStart = surface->_width, lowerEnd = -1;
+		int upperStart = surface->_width, upperEnd = -1;
+		const uint8_t * src = &images[srcPage * width + (x1 - xpos)];
+		for (int seg=x1; seg<=x2; seg++) {
+			uint8_t bits = *src++;
+			if (invert) bits = ~bits;
+			bits &= valid;
+			if (lower && _blit_byte(flip, &lowerSegs[seg], bits << shift, valid << shift, mode)) {
+				if (seg < lowerStart) lowerStart = seg;
+				lowerEnd = seg;
+			}
+			if (upper && _blit_byte(flip, &upperSegs[seg], bits >> (8 - shift), valid >> (8 - shift), mode)) {
+				if (seg < upperStart) upperStart = seg;
+				upperEnd = seg;
+			}
+		}
+		if (surface->_dev == NULL) continue;
+		if (lower) ssd1306_mark_dirty(surface->_dev, page, lowerStart, lowerEnd);
+		if (upper) ssd1306_mark_dirty(surface->_dev, page+1, upperStart, upperEnd);
+	}
+}
+
+// Set page format image to internal buffer at any position. Not show it.
+void ssd1306_blit(SSD1306_t * dev, int xpos, int ypos, const uint8_t * images, int width, int height, bool invert, ssd1306_draw_mode_t mode)
+{
+	ssd1306_surface_t surface = _device_surface(dev);
+	_ssd1306_surface_blit(&surface, xpos, ypos, images, width, height, invert, mode);
+}
+
+// Bit of row ypos in the byte of its page
+static inline uint8_t _pixel_mask(SSD1306_t * dev, int ypos)
+{
+	if (dev->_flip) return 0x80 >> (ypos & 7);
+	return 0x01 << (ypos & 7);
+}
+
+// Pixels outside of the panel are ignored unless bounds check is disabled in menuconfig.
+#if CONFIG_SSD1306_PIXEL_UNCHECKED
+#define PIXEL_IN_PANEL(dev, xpos, ypos) (true)
+#else
+#define PIXEL_IN_PANEL(dev, xpos, ypos) \
+	((unsigned)(xpos) < (unsigned)(dev)->_width && (unsigned)(ypos) < (unsigned)(dev)->_height)
+#endif
+
+static inline void _pixel(SSD1306_t * dev, int xpos, int ypos, span_op_t op)
+{
+	int page = ypos >> 3;
+	uint8_t mask = _pixel_mask(dev, ypos);
+	uint8_t * seg = &dev->_page[page]._segs[xpos];
+	if (op == SPAN_SET) {
+		*seg |= mask;
+	} else if (op == SPAN_CLEAR) {
+		*seg &= ~mask;
+	} else {
+		*seg ^= mask;
+	}
+	PAGE_t * _page = &dev->_page[page];
+	if (xpos < _page->_dirtyStart) _page->_dirtyStart = xpos;
+	if (xpos > _page->_dirtyEnd) _page->_dirtyEnd = xpos;
+}
+
+// Set pixel to internal buffer. Not show it.
+void ssd1306_set_pixel(SSD1306_t * dev, int xpos, int ypos, bool invert)
+{
+	if (!PIXEL_IN_PANEL(dev, xpos, ypos)) return;
+	_pixel(dev, xpos, ypos, invert ? SPAN_CLEAR : SPAN_SET);
+}
+
+// Invert pixel of internal buffer. Not show it.
+void ssd1306_toggle_pixel(SSD1306_t * dev, int xpos, int ypos)
+{
+	if (!PIXEL_IN_PANEL(dev, xpos, ypos)) return;
+	_pixel(dev, xpos, ypos, SPAN_XOR);
+}
+
+// Get pixel from internal buffer. Pixels outside of the panel are off.
+bool ssd1306_get_pixel(SSD1306_t * dev, int xpos, int ypos)
+{
+	if (!PIXEL_IN_PANEL(dev, xpos, ypos)) return false;
+	return (dev->_page[ypos >> 3]._segs[xpos] & _pixel_mask(dev, ypos)) != 0;
+}
+
+// Set many pixels to internal buffer at once. Not show it.
+void ssd1306_plot_points(SSD1306_t * dev, const ssd1306_point_t * points, int count, bool invert)
+{
+	span_op_t op = invert ? SPAN_CLEAR : SPAN_SET;
+	for (int i=0; i<count; i++) {
+		int xpos = points[i].x;
+		int ypos = points[i].y;
+		if (!PIXEL_IN_PANEL(dev, xpos, ypos)) continue;
+		_pixel(dev, xpos, ypos, op);
+	}
+}
+
+// Set horizontal line to internal buffer. Not show it.
+void ssd1306_hline(SSD1306_t * dev, int xpos, int ypos, int width, bool invert)
+{
+	if (width <= 0) return;
+	_ssd1306_span(dev, xpos, ypos, xpos + width - 1, ypos, invert ? SPAN_CLEAR : SPAN_SET);
+}
+
+// Set vertical line to internal buffer. Not show it.
+void ssd1306_vline(SSD1306_t * dev, int xpos, int ypos, int height, bool invert)
+{
+	if (height <= 0) return;
+	_ssd1306_span(dev, xpos, ypos, xpos, ypos + height - 1, invert ? SPAN_CLEAR : SPAN_SET);
+}
+
+// Set rectangle to internal buffer. Not show it.
+void ssd1306_rect(SSD1306_t * dev, int xpos, int ypos, int width, int height, bool invert)
+{
+	if (width <= 0 || height <= 0) return;
+	ssd1306_hline(dev, xpos, ypos, width, invert);
+	ssd1306_hline(dev, xpos, ypos + height - 1, width, invert);
+	ssd1306_vline(dev, xpos, ypos, height, invert);
+	ssd1306_vline(dev, xpos + width - 1, ypos, height, invert);
+}
+
+// Set filled rectangle to internal buffer. Not show it.
+void ssd1306_fill_rect(SSD1306_t * dev, int xpos, int ypos, int width, int height, bool invert)
+{
+	if (width <= 0 || height <= 0) return;
+	_ssd1306_span(dev, xpos, ypos, xpos + width - 1, ypos + height - 1, invert ? SPAN_CLEAR : SPAN_SET);
+}
+
+// Invert rectangle area of internal buffer. Not show it.
+void ssd1306_invert_rect(SSD1306_t * dev, int xpos, int ypos, int width, int height)
+{
+	if (width <= 0 || height <= 0) return;
+	_ssd1306_span(dev, xpos, ypos, xpos + width - 1, ypos + height - 1, SPAN_XOR);
+}
+
+// Curves are generated in one quadrant as runs of pixels and mirrored.
+// A run is a box of dx and dy offsets where one of them is a single value.
+// Corners of a rounded rectangle use different centers for each side.
+typedef struct {
+	SSD1306_t * dev;
+	int xl; // Center used for the left half
+	int xr; // Center used for the right half
+	int yt; // Center used for the upper half
+	int yb; // Center used for the lower half
+	bool fill;
+	span_op_t op;
+	int dx0, dx1, dy0, dy1; // Current run
+	bool active;
+} curve_t;
+
+static void _quad_emit(curve_t * q)
+{
+	if (q->active == false) return;
+	q->active = false;
+	SSD1306_t * dev = q->dev;
+	if (q->fill) {
+		// Every column of the run reaches dy1, so fill it from top to bottom at once
+		_ssd1306_span(dev, q->xr + q->dx0, q->yt - q->dy1, q->xr + q->dx1, q->yb + q->dy1, q->op);
+		_ssd1306_span(dev, q->xl - q->dx1, q->yt - q->dy1, q->xl - q->dx0, q->yb + q->dy1, q->op);
+	} else {
+		_ssd1306_span(dev, q->xr + q->dx0, q->yb + q->dy0, q->xr + q->dx1, q->yb + q->dy1, q->op);
+		_ssd1306_span(dev, q->xl - q->dx1, q->yb + q->dy0, q->xl - q->dx0, q->yb + q->dy1, q->op);
+		_ssd1306_span(dev, q->xr + q->dx0, q->yt - q->dy1, q->xr + q->dx1, q->yt - q->dy0, q->op);
+		_ssd1306_span(dev, q->xl - q->dx1, q->yt - q->dy1, q->xl - q->dx0, q->yt - q->dy0, q->op);
+	}
+}
+
+// Add one point of the quadrant. Points arrive as a connected curve.
+static void _quad_point(curve_t * q, int dx, int dy)
+{
+	if (q->active) {
+		bool single = (q->dx0 == q->dx1 && q->dy0 == q->dy1);
+		bool vertical = (q->dx0 == q->dx1 && dx == q->dx0);
+		bool horizontal = (q->dy0 == q->dy1 && dy == q->dy0);
+		if (vertical && (single || q->dy0 != q->dy1)) {
+			if (dy < q->dy0) q->dy0 = dy;
+			if (dy > q->dy1) q->dy1 = dy;
+			return;
+		}
+		if (horizontal && (single || q->dx0 != q->dx1)) {
+			if (dx < q->dx0) q->dx0 = dx;
+			if (dx > q->dx1) q->dx1 = dx;
+			return;
+		}
+		_quad_emit(q);
+	}
+	q->dx0 = q->dx1 = dx;
+	q->dy0 = q->dy1 = dy;
+	q->active = true;
+}
+
+// Bresenham type ellipse of one quadrant from (rx, 0) to (0, ry).
+// Integer only. Works for circles and very flat ellipses.
+static void _quad_ellipse(curve_t * q, int rx, int ry)
+{
+	int x = -rx;
+	int y = 0;
+	int64_t a2 = (int64_t)rx * rx;
+	int64_t b2 = (int64_t)ry * ry;
+	int64_t err = x * (2 * b2 + x) + b2;
+	int64_t e2;
+	do {
+		_quad_point(q, -x, y);
+		e2 = 2 * err;
+		if (e2 >= (x * 2 + 1) * b2) {
+			x++;
+			err += (x * 2 + 1) * b2;
+		}
+		if (e2 <= (y * 2 + 1) * a2) {
+			y++;
+			err += (y * 2 + 1) * a2;
+		}
+	} while (x <= 0);
+	// Finish the tip of flat ellipses
+	while (y++ < ry) {
+		_quad_point(q, 0, y);
+	}
+	_quad_emit(q);
+}
+
+static void _ssd1306_ellipse(SSD1306_t * dev, int xl, int xr, int yt, int yb, int rx, int ry, bool fill, bool invert)
+{
+	curve_t q = {
+		.dev = dev,
+		.xl = xl,
+		.xr = xr,
+		.yt = yt,
+		.yb = yb,
+		.fill = fill,
+		.op = invert ? SPAN_CLEAR : SPAN_SET,
+		.active = false
+	};
+	_quad_ellipse(&q, rx, ry);
+}
+
+// Set circle to internal buffer. Not show it.
+void ssd1306_circle(SSD1306_t * dev, int x0, int y0, int r, bool invert)
+{
+	if (r < 0) return;
+	_ssd1306_ellipse(dev, x0, x0, y0, y0, r, r, false, invert);
+}
+
+// Set filled circle to internal buffer. Not show it.
+void ssd1306_fill_circle(SSD1306_t * dev, int x0, int y0, int r, bool invert)
+{
+	if (r < 0) return;
+	_ssd1306_ellipse(dev, x0, x0, y0, y0, r, r, true, invert);
+}
+
+// Set ellipse to internal buffer. Not show it.
+void ssd1306_ellipse(SSD1306_t * dev, int x0, int y0, int rx, int ry, bool invert)
+{
+	if (rx < 0 || ry < 0) return;
+	_ssd1306_ellipse(dev, x0, x0, y0, y0, rx, ry, false, invert);
+}
+
+// Set filled ellipse to internal buffer. Not show it.
+void ssd1306_fill_ellipse(SSD1306_t * dev, int x0, int y0, int rx, int ry, bool invert)
+{
+	if (rx < 0 || ry < 0) return;
+	_ssd1306_ellipse(dev, x0, x0, y0, y0, rx, ry, true, invert);
+}
+
+static int _round_radius(int width, int height, int r)
+{
+	if (r < 0) r = 0;
+	if (r > (width - 1) / 2) r = (width - 1) / 2;
+	if (r > (height - 1) / 2) r = (height - 1) / 2;
+	return r;
+}
+
+// Set rounded rectangle to internal buffer. Not show it.
+void ssd1306_round_rect(SSD1306_t * dev, int xpos, int ypos, int width, int height, int r, bool invert)
+{
+	if (width <= 0 || height <= 0) return;
+	r = _round_radius(width, height, r);
+	int xl = xpos + r;
+	int xr = xpos + width - 1 - r;
+	int yt = ypos + r;
+	int yb = ypos + height - 1 - r;
+	_ssd1306_ellipse(dev, xl, xr, yt, yb, r, r, false, invert);
+	ssd1306_hline(dev, xl, ypos, xr - xl + 1, invert);
+	ssd1306_hline(dev, xl, ypos + height - 1, xr - xl + 1, invert);
+	ssd1306_vline(dev, xpos, yt, yb - yt + 1, invert);
+	ssd1306_vline(dev, xpos + width - 1, yt, yb - yt + 1, invert);
+}
+
+// Set filled rounded rectangle to internal buffer. Not show it.
+void ssd1306_fill_round_rect(SSD1306_t * dev, int xpos, int ypos, int width, int height, int r, bool invert)
+{
+	if (width <= 0 || height <= 0) return;
+	r = _round_radius(width, height, r);
+	int xl = xpos + r;
+	int xr = xpos + width - 1 - r;
+	int yt = ypos + r;
+	int yb = ypos + height - 1 - r;
+	_ssd1306_ellipse(dev, xl, xr, yt, yb, r, r, true, invert);
+	ssd1306_fill_rect(dev, xl, ypos, xr - xl + 1, height, invert);
+}
+
+// sin(0) to sin(90) degree scaled by 16384
+static const int16_t sin_table[91] = {
+	    0,   286,   572,   857,  1143,  1428,  1713,  1997,  2280,  2563,
+	 2845,  3126,  3406,  3686,  3964,  4240,  4516,  4790,  5063,  5334,
+	 5604,  5872,  6138,  6402,  6664,  6924,  7182,  7438,  7692,  7943,
+	 8192,  8438,  8682,  8923,  9162,  9397,  9630,  9860, 10087, 10311,
+	10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+	12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+	14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+	15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+	16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+	16384
+};
+
+static int _isin(int deg)
+{
+	deg = ((deg % 360) + 360) % 360;
+	if (deg <= 90) return sin_table[deg];
+	if (deg <= 180) return sin_table[180 - deg];
+	if (deg <= 270) return -sin_table[deg - 180];
+	return -sin_table[360 - deg];
+}
+
+static int _icos(int deg)
+{
+	return _isin(deg + 90);
+}
+
+// Angles are degrees clockwise from 3 o'clock, the direction of x to y on the panel.
+// Returns the sweep from start to end in the range of 0 to 360.
+static int _arc_sweep(int start, int end)
+{
+	if (end - start >= 360 || start - end >= 360) return 360;
+	int sweep = (((end - start) % 360) + 360) % 360;
+	if (sweep == 0 && end != start) sweep = 360;
+	return sweep;
+}
+
+// cross(S, P) >= 0 when P is clockwise from S on the panel
+static inline int64_t _cross(int ax, int ay, int bx, int by)
+{
+	return (int64_t)ax * by - (int64_t)ay * bx;
+}
+
+// Edges of the arc, computed once for all points
+typedef struct {
+	int sweep;
+	int sx, sy; // Start edge
+	int ex, ey; // End edge
+} arc_edge_t;
+
+static void _arc_edge(arc_edge_t * edge, int start, int sweep)
+{
+	edge->sweep = sweep;
+	edge->sx = _icos(start);
+	edge->sy = _isin(start);
+	edge->ex = _icos(start + sweep);
+	edge->ey = _isin(start + sweep);
+}
+
+static bool _in_arc(const arc_edge_t * edge, int px, int py)
+{
+	if (edge->sweep >= 360) return true;
+	if (edge->sweep <= 180) {
+		return _cross(edge->sx, edge->sy, px, py) >= 0 && _cross(px, py, edge->ex, edge->ey) >= 0;
+	}
+	// Outside of the remaining arc from end to start
+	return !(_cross(edge->ex, edge->ey, px, py) > 0 && _cross(px, py, edge->sx, edge->sy) > 0);
+}
+
+// Point of octant i for the midpoint circle step x, y
+static inline void _octant(int i, int x, int y, int * px, int * py)
+{
+	const int mx[8] = { 1, 0,  0, -1, -1,  0, 0,  1 };
+	const int my[8] = { 0, 1, -1,  0,  0, -1, 1,  0 };
+	*px = mx[i] * x + my[i] * y;
+	*py = (i == 0 || i == 3) ? y : (i == 4 || i == 7) ? -y : (i == 1 || i == 2) ? x : -x;
+}
+
+// Send points from to to of octant i with the same x as one span
+static void _arc_run(SSD1306_t * dev, int x0, int y0, int i, int x, int * from, int * to, span_op_t op)
+{
+	if (*from > *to) return;
+	int ax, ay, bx, by;
+	_octant(i, x, *from, &ax, &ay);
+	_octant(i, x, *to, &bx, &by);
+	_ssd1306_span(dev, x0 + (ax < bx ? ax : bx), y0 + (ay < by ? ay : by), x0 + (ax < bx ? bx : ax), y0 + (ay < by ? by : ay), op);
+	*from = 1;
+	*to = 0;
+}
+
+// Set arc of circle to internal buffer. Not show it.
+// Angles are degrees clockwise from 3 o'clock. start=180, end=360 is the upper half.
+void ssd1306_arc(SSD1306_t * dev, int x0, int y0, int r, int start, int end, bool invert)
+{
+	if (r < 0) return;
+	int sweep = _arc_sweep(start, end);
+	if (sweep == 0) return;
+	span_op_t op = invert ? SPAN_CLEAR : SPAN_SET;
+	arc_edge_t edge;
+	_arc_edge(&edge, start, sweep);
+
+	// Midpoint circle in all eight octants. While x stays the same, the points of
+	// an octant in the arc are one vertical or horizontal run.
+	int from[8], to[8];
+	for (int i=0; i<8; i++) {
+		from[i] = 1;
+		to[i] = 0;
+	}
+	int x = r;
+	int y = 0;
+	int err = 1 - r;
+	while (x >= y) {
+		for (int i=0; i<8; i++) {
+			int px, py;
+			_octant(i, x, y, &px, &py);
+			if (_in_arc(&edge, px, py)) {
+				if (from[i] > to[i]) from[i] = y;
+				to[i] = y;
+			} else {
+				_arc_run(dev, x0, y0, i, x, &from[i], &to[i], op);
+			}
+		}
+		y++;
+		if (err < 0) {
+			err += 2 * y + 1;
+		} else {
+			for (int i=0; i<8; i++) _arc_run(dev, x0, y0, i, x, &from[i], &to[i], op);
+			x--;
+			err += 2 * (y - x) + 1;
+		}
+	}
+	for (int i=0; i<8; i++) _arc_run(dev, x0, y0, i, x, &from[i], &to[i], op);
+}
+
+// Floor and ceil of a / b for any sign
+static int _div_floor(int64_t a, int64_t b)
+{
+	int64_t q = a / b;
+	if ((a % b != 0) && ((a < 0) != (b < 0))) q--;
+	return (int)q;
+}
+
+static int _div_ceil(int64_t a, int64_t b)
+{
+	return -_div_floor(-a, b);
+}
+
+// Limit dy range of column px to the half plane a * dy >= c
+static void _half_plane(int64_t a, int64_t c, int * lo, int * hi)
+{
+	if (a > 0) {
+		int v = _div_ceil(c, a);
+		if (v > *lo) *lo = v;
+	} else if (a < 0) {
+		int v = _div_floor(c, a);
+		if (v < *hi) *hi = v;
+	} else if (c > 0) {
+		*lo = 1;
+		*hi = 0;
+	}
+}
+
+// Fill the sector start to start+sweep(<=180) of a circle.
+// Every column on the panel is one vertical span clipped by the two edges of the sector.
+static void _fill_sector(SSD1306_t * dev, int x0, int y0, int r, int start, int sweep, span_op_t op)
+{
+	if (x0 + r < 0 || x0 - r >= dev->_width || y0 + r < 0 || y0 - r >= dev->_height) return;
+	arc_edge_t edge;
+	_arc_edge(&edge, start, sweep);
+
+	// Half height of the circle for each column of the panel. -1 is outside of the circle
+	int height[128];
+	for (int seg=0; seg<dev->_width; seg++) height[seg] = -1;
+	int x = r;
+	int y = 0;
+	int err = 1 - r;
+	while (x >= y) {
+		const int cols[4] = { x0 + x, x0 - x, x0 + y, x0 - y };
+		const int half[4] = { y, y, x, x };
+		for (int i=0; i<4; i++) {
+			if (cols[i] >= 0 && cols[i] < dev->_width) height[cols[i]] = half[i];
+		}
+		y++;
+		if (err < 0) {
+			err += 2 * y + 1;
+		} else {
+			x--;
+			err += 2 * (y - x) + 1;
+		}
+	}
+	for (int seg=0; seg<dev->_width; seg++) {
+		if (height[seg] < 0) continue;
+		int px = seg - x0;
+		int lo = -height[seg];
+		int hi = height[seg];
+		// cross(S, P) >= 0 : sx * dy >= sy * px
+		_half_plane(edge.sx, (int64_t)edge.sy * px, &lo, &hi);
+		// cross(P, E) >= 0 : -ex * dy >= -ey * px
+		_half_plane(-edge.ex, -(int64_t)edge.ey * px, &lo, &hi);
+		if (lo <= hi) _ssd1306_span(dev, seg, y0 + lo, seg, y0 + hi, op);
+	}
+}
+
+// Set filled arc(pie) to internal buffer. Not show it.
+// Angles are degrees clockwise from 3 o'clock.
+void ssd1306_fill_arc(SSD1306_t * dev, int x0, int y0, int r, int start, int end, bool invert)
+{
+	if (r < 0) return;
+	int sweep = _arc_sweep(start, end);
+	span_op_t op = invert ? SPAN_CLEAR : SPAN_SET;
+	while (sweep > 0) {
+		int part = (sweep > 180) ? 180 : sweep;
+		_fill_sector(dev, x0, y0, r, start, part, op);
+		start = start + part;
+		sweep = sweep - part;
+	}
+}
+
+// Bresenham line emitted as runs.
+// A shallow line is a series of horizontal runs and a steep line is a series of vertical runs.
+// run is called with the inclusive corners of each run.
+void ssd1306_line_runs(int x1, int y1, int x2, int y2, ssd1306_run_t run, void * ctx)
+{
+	int dx = abs(x2 - x1);
+	int dy = abs(y2 - y1);
+	int sx = (x2 > x1) ? 1 : -1;
+	int sy = (y2 > y1) ? 1 : -1;
+
+	if (dx >= dy) {
+		int E = -dx;
+		int start = x1;
+		for (int i=0; i<=dx; i++) {
+			E += 2 * dy;
+			if (E >= 0 || i == dx) {
+				int lo = (start < x1) ? start : x1;
+				int hi = (start < x1) ? x1 : start;
+				run(ctx, lo, y1, hi, y1);
+				y1 += sy;
+				E -= 2 * dx;
+				start = x1 + sx;
+			}
+			x1 += sx;
+		}
+	} else {
+		int E = -dy;
+		int start = y1;
+		for (int i=0; i<=dy; i++) {
+			E += 2 * dx;
+			if (E >= 0 || i == dy) {
+				int lo = (start < y1) ? start : y1;
+				int hi = (start < y1) ? y1 : start;
+				run(ctx, x1, lo, x1, hi);
+				x1 += sx;
+				E -= 2 * dy;
+				start = y1 + sy;
+			}
+			y1 += sy;
+		}
+	}
+}
+
+typedef struct {
+	SSD1306_t * dev;
+	span_op_t op;
+} line_ctx_t;
+
+static void _line_run(void * ctx, int x1, int y1, int x2, int y2)
+{
+	line_ctx_t * line = (line_ctx_t *)ctx;
+	_ssd1306_span(line->dev, x1, y1, x2, y2, line->op);
+}
+
+static void _ssd1306_line_span(SSD1306_t * dev, int x1, int y1, int x2, int y2, span_op_t op)
+{
+	line_ctx_t line = { dev, op };
+	ssd1306_line_runs(x1, y1, x2, y2, _line_run, &line);
+}
+
+// Set line to internal buffer. Not show it.
+void ssd1306_line(SSD1306_t * dev, int x1, int y1, int x2, int y2, bool invert)
+{
+	_ssd1306_line_span(dev, x1, y1, x2, y2, invert ? SPAN_CLEAR : SPAN_SET);
+}
+
+// Set polygon outline to internal buffer. Not show it.
+void ssd1306_polygon(SSD1306_t * dev, const ssd1306_point_t * points, int count, bool invert)
+{
+	span_op_t op = invert ? SPAN_CLEAR : SPAN_SET;
+	for (int i=0; i<count; i++) {
+		const ssd1306_point_t * p1 = &points[i];
+		const ssd1306_point_t * p2 = &points[(i + 1) % count];
+		_ssd1306_line_span(dev, p1->x, p1->y, p2->x, p2->y, op);
+	}
+}
+
+// Edge of polygon for the column scan. y is 16.16 fixed point at the current column.
+typedef struct {
+	int x1; // First column of the edge
+	int x2; // The edge is active while x1 <= x < x2
+	int64_t y;
+	int64_t dy; // y step per column
+} edge_t;
+
+// Set filled polygon to internal buffer. Not show it.
+// Convex and concave polygons are filled with even-odd rule.
+// Polygon is scanned column by column, so every run is a vertical span of whole bytes.
+void ssd1306_fill_polygon(SSD1306_t * dev, const ssd1306_point_t * points, int count, bool invert)
+{
+	if (count < 3) return;
+	if (count > SSD1306_MAX_POLYGON) {
+		ESP_LOGW(TAG, "polygon has too many points %d > %d", count, SSD1306_MAX_POLYGON);
+		return;
+	}
+	span_op_t op = invert ? SPAN_CLEAR : SPAN_SET;
+
+	// Edge table sorted by first column
+	edge_t edges[SSD1306_MAX_POLYGON];
+	int edgeLen = 0;
+	int xmin = points[0].x;
+	int xmax = points[0].x;
+	for (int i=0; i<count; i++) {
+		const ssd1306_point_t * p1 = &points[i];
+		const ssd1306_point_t * p2 = &points[(i + 1) % count];
+		if (p1->x < xmin) xmin = p1->x;
+		if (p1->x > xmax) xmax = p1->x;
+		if (p1->x == p2->x) continue; // Vertical edges are drawn by the outline
+		if (p1->x > p2->x) {
+			const ssd1306_point_t * wk = p1;
+			p1 = p2;
+			p2 = wk;
+		}
+		edge_t edge;
+		edge.x1 = p1->x;
+		edge.x2 = p2->x;
+		edge.dy = ((int64_t)(p2->y - p1->y) << 16) / (p2->x - p1->x);
+		edge.y = ((int64_t)p1->y << 16) + 0x8000;
+		int pos = edgeLen++;
+		while (pos > 0 && edges[pos-1].x1 > edge.x1) {
+			edges[pos] = edges[pos-1];
+			pos--;
+		}
+		edges[pos] = edge;
+	}
+
+	if (xmin < 0) xmin = 0;
+	if (xmax >= dev->_width) xmax = dev->_width - 1;
+
+	// Active edge list
+	edge_t * active[SSD1306_MAX_POLYGON];
+	int activeLen = 0;
+	int next = 0;
+	for (int x=xmin; x<=xmax; x++) {
+		// Add the edges starting at this column. Edges starting left of the panel are moved to it.
+		while (next < edgeLen && edges[next].x1 <= x) {
+			edge_t * edge = &edges[next++];
+			if (edge->x2 <= x) continue;
+			edge->y += edge->dy * (x - edge->x1);
+			active[activeLen++] = edge;
+		}
+		// Remove the finished edges and sort crossings from top to bottom
+		int crossLen = 0;
+		int cross[SSD1306_MAX_POLYGON];
+		for (int i=0; i<activeLen; i++) {
+			edge_t * edge = active[i];
+			if (edge->x2 <= x) {
+				active[i--] = active[--activeLen];
+				continue;
+			}
+			int y = (int)(edge->y >> 16);
+			int pos = crossLen++;
+			while (pos > 0 && cross[pos-1] > y) {
+				cross[pos] = cross[pos-1];
+				pos--;
+			}
+			cross[pos] = y;
+			edge->y += edge->dy;
+		}
+		for (int i=0; i+1<crossLen; i+=2) {
+			_ssd1306_span(dev, x, cross[i], x, cross[i+1], op);
+		}
+	}
+
+	// Outline covers the right most column and vertical edges
+	ssd1306_polygon(dev, points, count, invert);
+}
+
+// Set triangle to internal buffer. Not show it.
+void ssd1306_triangle(SSD1306_t * dev, int x1, int y1, int x2, int y2, int x3, int y3, bool invert)
+{
+	ssd1306_point_t points[3] = { {x1, y1}, {x2, y2}, {x3, y3} };
+	ssd1306_polygon(dev, points, 3, invert);
+}
+
+// Set filled triangle to internal buffer. Not show it.
+void ssd1306_fill_triangle(SSD1306_t * dev, int x1, int y1, int x2, int y2, int x3, int y3, bool invert)
+{
+	ssd1306_point_t points[3] = { {x1, y1}, {x2, y2}, {x3, y3} };
+	ssd1306_fill_polygon(dev, points, 3, invert);
+}
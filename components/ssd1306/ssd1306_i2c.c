@@ -43,6 +43,7 @@ void i2c_master_init(SSD1306_t * dev, int16_t sda, int16_t scl, int16_t reset)
 	}
 	dev->_address = I2CAddress;
 	dev->_flip = false;
+	dev->_lock = NULL;
 }
 
 void i2c_init(SSD1306_t * dev, int width, int height) {
@@ -106,7 +107,7 @@ void i2c_init(SSD1306_t * dev, int width, int height) {
 }
 
 
-void i2c_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width) {
+void i2c_display_image(SSD1306_t * dev, int page, int seg, const uint8_t * images, int width) {
 	i2c_cmd_handle_t cmd;
 
 	if (page >= dev->_pages) return;
@@ -121,6 +122,7 @@ void i2c_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int
 		_page = (dev->_pages - page) - 1;
 	}
 
+	ssd1306_lock(dev);
 	cmd = i2c_cmd_link_create();
 	i2c_master_start(cmd);
 	i2c_master_write_byte(cmd, (dev->_address << 1) | I2C_MASTER_WRITE, true);
@@ -147,6 +149,7 @@ void i2c_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int
 	i2c_master_stop(cmd);
 	i2c_master_cmd_begin(I2C_NUM, cmd, 10/portTICK_PERIOD_MS);
 	i2c_cmd_link_delete(cmd);
+	ssd1306_unlock(dev);
 }
 
 void i2c_contrast(SSD1306_t * dev, int contrast) {
@@ -155,6 +158,7 @@ void i2c_contrast(SSD1306_t * dev, int contrast) {
 	if (contrast < 0x0) _contrast = 0;
 	if (contrast > 0xFF) _contrast = 0xFF;
 
+	ssd1306_lock(dev);
 	cmd = i2c_cmd_link_create();
 	i2c_master_start(cmd);
 	i2c_master_write_byte(cmd, (dev->_address << 1) | I2C_MASTER_WRITE, true);
@@ -164,90 +168,145 @@ void i2c_contrast(SSD1306_t * dev, int contrast) {
 	i2c_master_stop(cmd);
 	i2c_master_cmd_begin(I2C_NUM, cmd, 10/portTICK_PERIOD_MS);
 	i2c_cmd_link_delete(cmd);
+	ssd1306_unlock(dev);
 }
 
 
-void i2c_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll) {
+// config is in GDDRAM pages and rows. NULL stops scrolling and sets display start line 0.
+void i2c_hardware_scroll(SSD1306_t * dev, const ssd1306_scroll_config_t * config) {
 	esp_err_t espRc;
 
+	ssd1306_lock(dev);
 	i2c_cmd_handle_t cmd = i2c_cmd_link_create();
 	i2c_master_start(cmd);
 
 	i2c_master_write_byte(cmd, (dev->_address << 1) | I2C_MASTER_WRITE, true);
 	i2c_master_write_byte(cmd, OLED_CONTROL_BYTE_CMD_STREAM, true);
+	// Scroll must be stopped before it is set
+	i2c_master_write_byte(cmd, OLED_CMD_DEACTIVE_SCROLL, true);			// 2E
 
-	if (scroll == SCROLL_RIGHT) {
-		i2c_master_write_byte(cmd, OLED_CMD_HORIZONTAL_RIGHT, true);	// 26
-		i2c_master_write_byte(cmd, 0x00, true); // Dummy byte
-		i2c_master_write_byte(cmd, 0x00, true); // Define start page address
-		i2c_master_write_byte(cmd, 0x07, true); // Frame frequency
-		i2c_master_write_byte(cmd, 0x07, true); // Define end page address
-		i2c_master_write_byte(cmd, 0x00, true); //
-		i2c_master_write_byte(cmd, 0xFF, true); //
-		i2c_master_write_byte(cmd, OLED_CMD_ACTIVE_SCROLL, true);		// 2F
-	} 
+	if (config == NULL) {
+		// Vertical scroll leaves the start line moved
+		i2c_master_write_byte(cmd, OLED_CMD_SET_DISPLAY_START_LINE, true);	// 40
+	}
 
-	if (scroll == SCROLL_LEFT) {
-		i2c_master_write_byte(cmd, OLED_CMD_HORIZONTAL_LEFT, true);		// 27
+	if (config != NULL && config->vertical == 0) {
+		if (config->horizontal == SCROLL_LEFT) {
+			i2c_master_write_byte(cmd, OLED_CMD_HORIZONTAL_LEFT, true);		// 27
+		} else {
+			i2c_master_write_byte(cmd, OLED_CMD_HORIZONTAL_RIGHT, true);	// 26
+		}
 		i2c_master_write_byte(cmd, 0x00, true); // Dummy byte
-		i2c_master_write_byte(cmd, 0x00, true); // Define start page address
-		i2c_master_write_byte(cmd, 0x07, true); // Frame frequency
-		i2c_master_write_byte(cmd, 0x07, true); // Define end page address
-		i2c_master_write_byte(cmd, 0x00, true); //
-		i2c_master_write_byte(cmd, 0xFF, true); //
+		i2c_master_write_byte(cmd, config->startPage, true); // Define start page address
+		i2c_master_write_byte(cmd, config->frames, true); // Frame frequency
+		i2c_master_write_byte(cmd, config->endPage, true); // Define end page address
+		if (config->start == 0 && config->end == dev->_width - 1) {
+			i2c_master_write_byte(cmd, 0x00, true); //
+			i2c_master_write_byte(cmd, 0xFF, true); //
+		} else {
+			i2c_master_write_byte(cmd, config->start + CONFIG_OFFSETX, true); // Start column
+			i2c_master_write_byte(cmd, config->end + CONFIG_OFFSETX, true); // End column
+		}
 		i2c_master_write_byte(cmd, OLED_CMD_ACTIVE_SCROLL, true);		// 2F
-	} 
-
-	if (scroll == SCROLL_DOWN) {
-		i2c_master_write_byte(cmd, OLED_CMD_CONTINUOUS_SCROLL, true);	// 29
-		i2c_master_write_byte(cmd, 0x00, true); // Dummy byte
-		i2c_master_write_byte(cmd, 0x00, true); // Define start page address
-		i2c_master_write_byte(cmd, 0x07, true); // Frame frequency
-		//i2c_master_write_byte(cmd, 0x01, true); // Define end page address
-		i2c_master_write_byte(cmd, 0x00, true); // Define end page address
-		i2c_master_write_byte(cmd, 0x3F, true); // Vertical scrolling offset
+	}
 
+	if (config != NULL && config->vertical != 0) {
 		i2c_master_write_byte(cmd, OLED_CMD_VERTICAL, true);			// A3
-		i2c_master_write_byte(cmd, 0x00, true);
-		if (dev->_height == 64)
-		//i2c_master_write_byte(cmd, 0x7F, true);
-		i2c_master_write_byte(cmd, 0x40, true);
-		if (dev->_height == 32)
-		i2c_master_write_byte(cmd, 0x20, true);
+		i2c_master_write_byte(cmd, config->areaTop, true);
+		i2c_master_write_byte(cmd, config->areaRows, true);
+		if (config->horizontal == SCROLL_LEFT) {
+			i2c_master_write_byte(cmd, OLED_CMD_CONTINUOUS_SCROLL_LEFT, true);	// 2A
+		} else {
+			i2c_master_write_byte(cmd, OLED_CMD_CONTINUOUS_SCROLL, true);	// 29
+		}
+		i2c_master_write_byte(cmd, config->horizontal == SCROLL_STOP ? 0x00 : 0x01, true); // Horizontal scroll
+		i2c_master_write_byte(cmd, config->startPage, true); // Define start page address
+		i2c_master_write_byte(cmd, config->frames, true); // Frame frequency
+		i2c_master_write_byte(cmd, config->endPage, true); // Define end page address
+		i2c_master_write_byte(cmd, config->vertical, true); // Vertical scrolling offset
 		i2c_master_write_byte(cmd, OLED_CMD_ACTIVE_SCROLL, true);		// 2F
 	}
 
-	if (scroll == SCROLL_UP) {
-		i2c_master_write_byte(cmd, OLED_CMD_CONTINUOUS_SCROLL, true);	// 29
-		i2c_master_write_byte(cmd, 0x00, true); // Dummy byte
-		i2c_master_write_byte(cmd, 0x00, true); // Define start page address
-		i2c_master_write_byte(cmd, 0x07, true); // Frame frequency
-		//i2c_master_write_byte(cmd, 0x01, true); // Define end page address
-		i2c_master_write_byte(cmd, 0x00, true); // Define end page address
-		i2c_master_write_byte(cmd, 0x01, true); // Vertical scrolling offset
+	i2c_master_stop(cmd);
+	espRc = i2c_master_cmd_begin(I2C_NUM, cmd, 10/portTICK_PERIOD_MS);
+	if (espRc == ESP_OK) {
+		ESP_LOGD(tag, "Scroll command succeeded");
+	} else {
+		ESP_LOGE(tag, "Scroll command failed. code: 0x%.2X", espRc);
+	}
 
-		i2c_master_write_byte(cmd, OLED_CMD_VERTICAL, true);			// A3
-		i2c_master_write_byte(cmd, 0x00, true);
-		if (dev->_height == 64)
-		//i2c_master_write_byte(cmd, 0x7F, true);
-		i2c_master_write_byte(cmd, 0x40, true);
-		if (dev->_height == 32)
-		i2c_master_write_byte(cmd, 0x20, true);
-		i2c_master_write_byte(cmd, OLED_CMD_ACTIVE_SCROLL, true);		// 2F
+	i2c_cmd_link_delete(cmd);
+	ssd1306_unlock(dev);
+}
+
+// Scroll GDDRAM of the window by one column. config is in GDDRAM pages.
+void i2c_content_scroll(SSD1306_t * dev, const ssd1306_scroll_config_t * config) {
+	esp_err_t espRc;
+
+	ssd1306_lock(dev);
+	i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+	i2c_master_start(cmd);
+	i2c_master_write_byte(cmd, (dev->_address << 1) | I2C_MASTER_WRITE, true);
+	i2c_master_write_byte(cmd, OLED_CONTROL_BYTE_CMD_STREAM, true);
+	if (config->horizontal == SCROLL_LEFT) {
+		i2c_master_write_byte(cmd, OLED_CMD_CONTENT_SCROLL_LEFT, true);	// 2D
+	} else {
+		i2c_master_write_byte(cmd, OLED_CMD_CONTENT_SCROLL_RIGHT, true);	// 2C
 	}
+	i2c_master_write_byte(cmd, 0x00, true); // Dummy byte
+	i2c_master_write_byte(cmd, config->startPage, true); // Define start page address
+	i2c_master_write_byte(cmd, 0x01, true); // Dummy byte
+	i2c_master_write_byte(cmd, config->endPage, true); // Define end page address
+	i2c_master_write_byte(cmd, config->start + CONFIG_OFFSETX, true); // Start column
+	i2c_master_write_byte(cmd, config->end + CONFIG_OFFSETX, true); // End column
+	i2c_master_stop(cmd);
 
-	if (scroll == SCROLL_STOP) {
-		i2c_master_write_byte(cmd, OLED_CMD_DEACTIVE_SCROLL, true);		// 2E
+	espRc = i2c_master_cmd_begin(I2C_NUM, cmd, 10/portTICK_PERIOD_MS);
+	if (espRc == ESP_OK) {
+		ESP_LOGD(tag, "Content scroll command succeeded");
+	} else {
+		ESP_LOGE(tag, "Content scroll command failed. code: 0x%.2X", espRc);
 	}
 
+	i2c_cmd_link_delete(cmd);
+	ssd1306_unlock(dev);
+}
+
+void i2c_hardware_zoom(SSD1306_t * dev, int line, bool enable) {
+	esp_err_t espRc;
+
+	ssd1306_lock(dev);
+	i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+	i2c_master_start(cmd);
+	i2c_master_write_byte(cmd, (dev->_address << 1) | I2C_MASTER_WRITE, true);
+	i2c_master_write_byte(cmd, OLED_CONTROL_BYTE_CMD_STREAM, true);
+	i2c_master_write_byte(cmd, OLED_CMD_SET_DISPLAY_START_LINE | (line & 0x3F), true);	// 40
+	i2c_master_write_byte(cmd, OLED_CMD_SET_ZOOM, true);				// D6
+	i2c_master_write_byte(cmd, enable ? 0x01 : 0x00, true);
 	i2c_master_stop(cmd);
+
 	espRc = i2c_master_cmd_begin(I2C_NUM, cmd, 10/portTICK_PERIOD_MS);
 	if (espRc == ESP_OK) {
-		ESP_LOGD(tag, "Scroll command succeeded");
+		ESP_LOGD(tag, "Zoom command succeeded");
 	} else {
-		ESP_LOGE(tag, "Scroll command failed. code: 0x%.2X", espRc);
+		ESP_LOGE(tag, "Zoom command failed. code: 0x%.2X", espRc);
 	}
 
 	i2c_cmd_link_delete(cmd);
+	ssd1306_unlock(dev);
 }
 
+void i2c_display_start_line(SSD1306_t * dev, int line) {
+	i2c_cmd_handle_t cmd;
+
+	ssd1306_lock(dev);
+	cmd = i2c_cmd_link_create();
+	i2c_master_start(cmd);
+	i2c_master_write_byte(cmd, (dev->_address << 1) | I2C_MASTER_WRITE, true);
+	i2c_master_write_byte(cmd, OLED_CONTROL_BYTE_CMD_SINGLE, true);
+	i2c_master_write_byte(cmd, OLED_CMD_SET_DISPLAY_START_LINE | (line & 0x3F), true);	// 40
+	i2c_master_stop(cmd);
+	i2c_master_cmd_begin(I2C_NUM, cmd, 10/portTICK_PERIOD_MS);
+	i2c_cmd_link_delete(cmd);
+	ssd1306_unlock(dev);
+}
@@ -0,0 +1,299 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "esp_log.h"
+
+#include "ssd1306.h"
+#include "ssd1306_private.h"
+#include "font8x8_basic.h"
+
+#define TAG "SSD1306"
+
+// Kinds of commands in a display list
+typedef enum {
+	LIST_FILL = 1, // Set the area
+	LIST_CLEAR = 2, // Clear the area
+	LIST_BLIT = 3 // Image of width * ((height + 7) / 8) bytes follows the command
+} list_kind_t;
+
+// Command of a display list. Stored unaligned, so read and write it with memcpy.
+typedef struct {
+	uint8_t kind;
+	uint8_t mode;
+	int16_t x;
+	int16_t y;
+	int16_t width;
+	int16_t height;
+} list_cmd_t;
+
+// Use buffer of size bytes as a display list. buffer is used as it is, nothing is allocated.
+void ssd1306_list_init(ssd1306_list_t * list, uint8_t * buffer, int size)
+{
+	list->_buffer = buffer;
+	list->_size = size;
+	ssd1306_list_clear(list);
+}
+
+// Remove all commands.
+void ssd1306_list_clear(ssd1306_list_t * list)
+{
+	list->_used = 0;
+	list->_last = -1;
+	list->_overflow = false;
+	list->_x1 = 0;
+	list->_y1 = 0;
+	list->_x2 = -1;
+	list->_y2 = -1;
+}
+
+static void _list_bounds(ssd1306_list_t * list, int x, int y, int width, int height)
+{
+	if (list->_x1 > list->_x2) {
+		list->_x1 = x;
+		list->_y1 = y;
+		list->_x2 = x + width - 1;
+		list->_y2 = y + height - 1;
+		return;
+	}
+	if (x < list->_x1) list->_x1 = x;
+	if (y < list->_y1) list->_y1 = y;
+	if (x + width - 1 > list->_x2) list->_x2 = x + width - 1;
+	if (y + height - 1 > list->_y2) list->_y2 = y + height - 1;
+}
+
+// Commands store the area as int16_t
+static bool _list_range(int x, int y, int width, int height)
+{
+	if (x < INT16_MIN || x > INT16_MAX || y < INT16_MIN || y > INT16_MAX
+		|| width > INT16_MAX || height > INT16_MAX) {
+		ESP_LOGE(TAG, "display list area %d,%d %dx%d is out of range", x, y, width, height);
+		return false;
+	}
+	return true;
+}
+
+// Add a command with room for bytes of image after it.
+// Returns the offset of the command, or -1 when it does not fit.
+static int _list_append(ssd1306_list_t * list, const list_cmd_t * cmd, int bytes)
+{
+	if (list->_used + (int)sizeof(list_cmd_t) + bytes > list->_size) {
+		if (!list->_overflow) ESP_LOGW(TAG, "display list of %d bytes is full", list->_size);
+		list->_overflow = true;
+		return -1;
+	}
+	int offset = list->_used;
+	memcpy(&list->_buffer[offset], cmd, sizeof(list_cmd_t));
+	list->_used = offset + sizeof(list_cmd_t) + bytes;
+	list->_last = offset;
+	return offset;
+}
+
+// Fills next to or inside the last fill of the same kind are merged into it.
+static bool _list_fill(ssd1306_list_t * list, int x, int y, int width, int height, list_kind_t kind)
+{
+	if (width <= 0 || height <= 0) return true;
+	if (!_list_range(x, y, width, height)) return false;
+	if (list->_last >= 0) {
+		list_cmd_t last;
+		memcpy(&last, &list->_buffer[list->_last], sizeof(list_cmd_t));
+		bool merged = false;
+		if (last.kind != kind) {
+			// Different kind can not be merged
+		} else if (last.y == y && last.height == height && (last.x + last.width == x || x + width == last.x)
+			&& last.width + width <= INT16_MAX) {
+			if (x < last.x) last.x = x;
+			last.width = last.width + width;
+			merged = true;
+		} else if (last.x == x && last.width == width && (last.y + last.height == y || y + height == last.y)
+			&& last.height + height <= INT16_MAX) {
+			if (y < last.y) last.y = y;
+			last.height = last.height + height;
+			merged = true;
+		} else if (x >= last.x && y >= last.y && x + width <= last.x + last.width && y + height <= last.y + last.height) {
+			merged = true;
+		}
+		if (merged) {
+			memcpy(&list->_buffer[list->_last], &last, sizeof(list_cmd_t));
+			_list_bounds(list, x, y, width, height);
+			return true;
+		}
+	}
+	list_cmd_t cmd = { kind, DRAW_COPY, x, y, width, height };
+	if (_list_append(list, &cmd, 0) < 0) return false;
+	_list_bounds(list, x, y, width, height);
+	return true;
+}
+
+// Room for the image of a blit. An image of one page right after the last one
+// on the same row is appended to it, so a line of text is one command.
+// Returns where to write the image, or NULL when it does not fit.
+static uint8_t * _list_image(ssd1306_list_t * list, int x, int y, int width, int height, ssd1306_draw_mode_t mode)
+{
+	if (!_list_range(x, y, width, height)) return NULL;
+	if (list->_last >= 0 && height <= 8) {
+		list_cmd_t last;
+		memcpy(&last, &list->_buffer[list->_last], sizeof(list_cmd_t));
+		if (last.kind == LIST_BLIT && last.mode == mode && last.y == y && last.height == height
+			&& last.x + last.width == x && last.width + width <= INT16_MAX && list->_used + width <= list->_size) {
+			uint8_t * image = &list->_buffer[list->_used];
+			last.width = last.width + width;
+			memcpy(&list->_buffer[list->_last], &last, sizeof(list_cmd_t));
+			list->_used = list->_used + width;
+			_list_bounds(list, x, y, width, height);
+			return image;
+		}
+	}
+	list_cmd_t cmd = { LIST_BLIT, mode, x, y, width, height };
+	int offset = _list_append(list, &cmd, width * ((height + 7) / 8));
+	if (offset < 0) return NULL;
+	_list_bounds(list, x, y, width, height);
+	return &list->_buffer[offset + sizeof(list_cmd_t)];
+}
+
+// Record ssd1306_fill_rect.
+// Returns false when the list is full.
+bool ssd1306_list_fill_rect(ssd1306_list_t * list, int xpos, int ypos, int width, int height, bool invert)
+{
+	return _list_fill(list, xpos, ypos, width, height, invert ? LIST_CLEAR : LIST_FILL);
+}
+
+typedef struct {
+	ssd1306_list_t * list;
+	list_kind_t kind;
+	bool ok;
+} list_line_t;
+
+static void _list_line_run(void * ctx, int x1, int y1, int x2, int y2)
+{
+	list_line_t * line = (list_line_t *)ctx;
+	if (!_list_fill(line->list, x1, y1, x2 - x1 + 1, y2 - y1 + 1, line->kind)) line->ok = false;
+}
+
+// Record ssd1306_line. The line is stored as the runs ssd1306_line draws.
+// Returns false when the list is full.
+bool ssd1306_list_line(ssd1306_list_t * list, int x1, int y1, int x2, int y2, bool invert)
+{
+	list_line_t line = { list, invert ? LIST_CLEAR : LIST_FILL, true };
+	ssd1306_line_runs(x1, y1, x2, y2, _list_line_run, &line);
+	return line.ok;
+}
+
+// Record ssd1306_blit. images is copied, so it can be changed after this.
+// Returns false when the list is full.
+bool ssd1306_list_blit(ssd1306_list_t * list, int xpos, int ypos, const uint8_t * images, int width, int height, bool invert, ssd1306_draw_mode_t mode)
+{
+	if (width <= 0 || height <= 0) return true;
+	uint8_t * image = _list_image(list, xpos, ypos, width, height, mode);
+	if (image == NULL) return false;
+	int bytes = width * ((height + 7) / 8);
+	memcpy(image, images, bytes);
+	if (invert) ssd1306_invert(image, bytes);
+	return true;
+}
+
+// Record ssd1306_draw_text. Glyphs are copied when recorded, so replay is one blit per line.
+// Returns false when the list is full.
+bool ssd1306_list_text(ssd1306_list_t * list, int xpos, int ypos, char * text, int text_len, bool invert, ssd1306_draw_mode_t mode)
+{
+	if (text_len <= 0) return true;
+	if (text_len > INT16_MAX / 8) {
+		ESP_LOGE(TAG, "display list text of %d characters is too long", text_len);
+		return false;
+	}
+	uint8_t * image = _list_image(list, xpos, ypos, text_len * 8, 8, mode);
+	if (image == NULL) return false;
+	for (int i=0; i<text_len; i++) {
+		uint8_t code = (uint8_t)text[i];
+		if (code >= 128) code = ' ';
+		memcpy(&image[i*8], font8x8_basic_tr[code], 8);
+	}
+	if (invert) ssd1306_invert(image, text_len * 8);
+	return true;
+}
+
+// Record ssd1306_draw_string. UTF-8 and kerning are resolved when recorded,
+// so replay is one blit of the whole text of font->height rows.
+// With invert the whole text rect is inverted, as ssd1306_draw_string does in DRAW_COPY.
+// Returns false when the list is full.
+bool ssd1306_list_string(ssd1306_list_t * list, const ssd1306_font_t * font, int xpos, int ypos, char * text, int text_len, bool invert, ssd1306_draw_mode_t mode)
+{
+	if (text_len <= 0) return true;
+	int width = ssd1306_string_width(font, text, text_len);
+	if (width <= 0) return true;
+	uint8_t * image = _list_image(list, xpos, ypos, width, font->height, mode);
+	if (image == NULL) return false;
+	_ssd1306_string_image(font, text, text_len, image, width);
+	if (invert) ssd1306_invert(image, width * ((font->height + 7) / 8));
+	return true;
+}
+
+// Area drawn by the list, to know what to draw again when it changes.
+// Returns false when the list is empty.
+bool ssd1306_list_bounds(const ssd1306_list_t * list, int * xpos, int * ypos, int * width, int * height)
+{
+	if (list->_x1 > list->_x2) return false;
+	*xpos = list->_x1;
+	*ypos = list->_y1;
+	*width = list->_x2 - list->_x1 + 1;
+	*height = list->_y2 - list->_y1 + 1;
+	return true;
+}
+
+// Two lists recorded by the same calls are the same. A screen whose list is the same needs no redraw.
+bool ssd1306_list_equal(const ssd1306_list_t * list1, const ssd1306_list_t * list2)
+{
+	if (list1->_used != list2->_used) return false;
+	return memcmp(list1->_buffer, list2->_buffer, list1->_used) == 0;
+}
+
+typedef void (*list_fill_t)(void * target, int xpos, int ypos, int width, int height, bool invert);
+typedef void (*list_blit_t)(void * target, int xpos, int ypos, const uint8_t * images, int width, int height, ssd1306_draw_mode_t mode);
+
+static void _list_replay(const ssd1306_list_t * list, int xpos, int ypos, list_fill_t fill, list_blit_t blit, void * target)
+{
+	int offset = 0;
+	while (offset < list->_used) {
+		list_cmd_t cmd;
+		memcpy(&cmd, &list->_buffer[offset], sizeof(list_cmd_t));
+		offset = offset + sizeof(list_cmd_t);
+		if (cmd.kind == LIST_BLIT) {
+			blit(target, cmd.x + xpos, cmd.y + ypos, &list->_buffer[offset], cmd.width, cmd.height, cmd.mode);
+			offset = offset + cmd.width * ((cmd.height + 7) / 8);
+		} else {
+			fill(target, cmd.x + xpos, cmd.y + ypos, cmd.width, cmd.height, cmd.kind == LIST_CLEAR);
+		}
+	}
+}
+
+static void _device_fill(void * target, int xpos, int ypos, int width, int height, bool invert)
+{
+	ssd1306_fill_rect((SSD1306_t *)target, xpos, ypos, width, height, invert);
+}
+
+static void _device_blit(void * target, int xpos, int ypos, const uint8_t * images, int width, int height, ssd1306_draw_mode_t mode)
+{
+	ssd1306_blit((SSD1306_t *)target, xpos, ypos, images, width, height, false, mode);
+}
+
+// Draw the list to internal buffer moved by xpos, ypos. Not show it.
+// ssd1306_blit marks only changed segments dirty, so replaying an unchanged screen sends nothing.
+void ssd1306_list_replay(SSD1306_t * dev, const ssd1306_list_t * list, int xpos, int ypos)
+{
+	_list_replay(list, xpos, ypos, _device_fill, _device_blit, dev);
+}
+
+static void _canvas_fill(void * target, int xpos, int ypos, int width, int height, bool invert)
+{
+	ssd1306_canvas_fill_rect((ssd1306_canvas_t *)target, xpos, ypos, width, height, invert);
+}
+
+static void _canvas_blit(void * target, int xpos, int ypos, const uint8_t * images, int width, int height, ssd1306_draw_mode_t mode)
+{
+	ssd1306_canvas_blit((ssd1306_canvas_t *)target, xpos, ypos, images, width, height, false, mode);
+}
+
+// Draw the list to canvas moved by xpos, ypos. Not show it.
+void ssd1306_list_replay_canvas(ssd1306_canvas_t * canvas, const ssd1306_list_t * list, int xpos, int ypos)
+{
+	_list_replay(list, xpos, ypos, _canvas_fill, _canvas_blit, canvas);
+}
@@ -0,0 +1,207 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_log.h"
+
+#include "ssd1306.h"
+#include "ssd1306_private.h"
+
+#define TAG "SSD1306"
+
+#ifndef ESP_PLATFORM
+// pthread can not tell the owner of a mutex, so it is kept here.
+// owner is written before count, so a task seeing count > 0 sees the current owner.
+struct ssd1306_host_mutex {
+	pthread_mutex_t mutex;
+	pthread_t owner;
+	int count; // Times taken by owner. 0 means free
+};
+#endif
+
+// Recursive, so a function holding the lock can call another one that takes it.
+static ssd1306_mutex_t _mutex_create(void)
+{
+#ifdef ESP_PLATFORM
+	return xSemaphoreCreateRecursiveMutex();
+#else
+	ssd1306_mutex_t mutex = calloc(1, sizeof(struct ssd1306_host_mutex));
+	if (mutex == NULL) return NULL;
+	pthread_mutexattr_t attr;
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&mutex->mutex, &attr);
+	pthread_mutexattr_destroy(&attr);
+	return mutex;
+#endif
+}
+
+static void _mutex_delete(ssd1306_mutex_t mutex)
+{
+	if (mutex == NULL) return;
+#ifdef ESP_PLATFORM
+	vSemaphoreDelete(mutex);
+#else
+	pthread_mutex_destroy(&mutex->mutex);
+	free(mutex);
+#endif
+}
+
+#ifndef ESP_PLATFORM
+static void _mutex_taken(ssd1306_mutex_t mutex)
+{
+	__atomic_store_n(&mutex->owner, pthread_self(), __ATOMIC_RELAXED);
+	__atomic_store_n(&mutex->count, mutex->count + 1, __ATOMIC_RELEASE);
+}
+#endif
+
+static void _mutex_take(ssd1306_mutex_t mutex)
+{
+#ifdef ESP_PLATFORM
+	xSemaphoreTakeRecursive(mutex, portMAX_DELAY);
+#else
+	pthread_mutex_lock(&mutex->mutex);
+	_mutex_taken(mutex);
+#endif
+}
+
+// Take mutex only when it is free or already held by the caller.
+static bool _mutex_try(ssd1306_mutex_t mutex)
+{
+#ifdef ESP_PLATFORM
+	return xSemaphoreTakeRecursive(mutex, 0) == pdTRUE;
+#else
+	if (pthread_mutex_trylock(&mutex->mutex) != 0) return false;
+	_mutex_taken(mutex);
+	return true;
+#endif
+}
+
+static void _mutex_give(ssd1306_mutex_t mutex)
+{
+#ifdef ESP_PLATFORM
+	xSemaphoreGiveRecursive(mutex);
+#else
+	__atomic_store_n(&mutex->count, mutex->count - 1, __ATOMIC_RELEASE);
+	pthread_mutex_unlock(&mutex->mutex);
+#endif
+}
+
+// True when the calling task holds mutex.
+static bool _mutex_held(ssd1306_mutex_t mutex)
+{
+#ifdef ESP_PLATFORM
+	return xSemaphoreGetMutexHolder(mutex) == xTaskGetCurrentTaskHandle();
+#else
+	if (__atomic_load_n(&mutex->count, __ATOMIC_ACQUIRE) == 0) return false;
+	return pthread_equal(__atomic_load_n(&mutex->owner, __ATOMIC_RELAXED), pthread_self());
+#endif
+}
+
+static void _delete_locks(SSD1306_t * dev)
+{
+	_mutex_delete(dev->_lock);
+	dev->_lock = NULL;
+	for (int page=0; page<8; page++) {
+		_mutex_delete(dev->_pageLock[page]);
+		dev->_pageLock[page] = NULL;
+	}
+}
+
+// Make dev safe to use from several tasks. Call it after ssd1306_init.
+// Every transfer to the panel holds the device lock, so commands of two tasks never mix.
+// Functions sending internal buffer hold the pages they send. See ssd1306.h for the order of the locks.
+// Returns false when the mutexes can not be created.
+bool ssd1306_enable_lock(SSD1306_t * dev)
+{
+	if (dev->_lock != NULL) return true;
+	memset(dev->_pageLock, 0, sizeof(dev->_pageLock));
+	for (int page=0; page<8; page++) {
+		dev->_pageLock[page] = _mutex_create();
+		if (dev->_pageLock[page] == NULL) {
+			ESP_LOGE(TAG, "page lock can not be created");
+			_delete_locks(dev);
+			return false;
+		}
+	}
+	ssd1306_mutex_t lock = _mutex_create();
+	if (lock == NULL) {
+		ESP_LOGE(TAG, "device lock can not be created");
+		_delete_locks(dev);
+		return false;
+	}
+	dev->_lock = lock;
+	return true;
+}
+
+// No task may use dev while the locks are deleted.
+void ssd1306_disable_lock(SSD1306_t * dev)
+{
+	if (dev->_lock == NULL) return;
+	_delete_locks(dev);
+}
+
+// Hold the bus and the glyph cache. Several transfers in a row are not mixed with other tasks.
+void ssd1306_lock(SSD1306_t * dev)
+{
+	if (dev->_lock == NULL) return;
+	_mutex_take(dev->_lock);
+}
+
+void ssd1306_unlock(SSD1306_t * dev)
+{
+	if (dev->_lock == NULL) return;
+	_mutex_give(dev->_lock);
+}
+
+// Highest page held by the calling task, or -1.
+static int _held_page(SSD1306_t * dev)
+{
+	for (int page=dev->_pages-1; page>=0; page--) {
+		if (_mutex_held(dev->_pageLock[page])) return page;
+	}
+	return -1;
+}
+
+// Hold pages startPage to endPage of internal buffer while drawing them.
+// A page already held by the task is taken again. New pages must come after the held ones
+// in page order, so taking a page before a held one is asserted.
+void ssd1306_lock_region(SSD1306_t * dev, int startPage, int endPage)
+{
+	if (dev->_lock == NULL) return;
+	if (startPage < 0) startPage = 0;
+	if (endPage >= dev->_pages) endPage = dev->_pages - 1;
+	int held = _held_page(dev);
+	for (int page=startPage; page<=endPage; page++) {
+		if (!_mutex_held(dev->_pageLock[page])) {
+			assert(page > held);
+			held = page;
+		}
+		_mutex_take(dev->_pageLock[page]);
+	}
+}
+
+void ssd1306_unlock_region(SSD1306_t * dev, int startPage, int endPage)
+{
+	if (dev->_lock == NULL) return;
+	if (startPage < 0) startPage = 0;
+	if (endPage >= dev->_pages) endPage = dev->_pages - 1;
+	for (int page=endPage; page>=startPage; page--) {
+		_mutex_give(dev->_pageLock[page]);
+	}
+}
+
+// Hold page while internal buffer of it is sent by a flush.
+// A task holding no page waits for it. A task holding a region takes a page it does not hold
+// only when it is free, so a flush with a region held never waits for the region of another task.
+// Returns false when the page is held by another task. It is not sent and stays dirty.
+// Release a taken page with ssd1306_unlock_region.
+bool _ssd1306_lock_flush(SSD1306_t * dev, int page)
+{
+	if (dev->_lock == NULL) return true;
+	if (_mutex_held(dev->_pageLock[page]) || _held_page(dev) < 0) {
+		_mutex_take(dev->_pageLock[page]);
+		return true;
+	}
+	return _mutex_try(dev->_pageLock[page]);
+}
@@ -0,0 +1,171 @@
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "ssd1306.h"
+
+#define TAG "SSD1306"
+
+static void _pipeline_send_page(SSD1306_t * dev, int page, int seg, const uint8_t * images, int width)
+{
+	ssd1306_lock_region(dev, page, page);
+	if (dev->_address == SPIAddress) {
+		spi_display_image(dev, page, seg, images, width);
+	} else {
+		i2c_display_image(dev, page, seg, images, width);
+	}
+	ssd1306_unlock_region(dev, page, page);
+}
+
+// Send a frame of the queue. Only the segments changed from the last frame are sent.
+static void _pipeline_send(ssd1306_pipeline_t * pipe, uint8_t frame[8][128])
+{
+	SSD1306_t * dev = pipe->_dev;
+	for (int page=0; page<dev->_pages; page++) {
+		uint8_t * shown = pipe->_shown[page];
+		int start = 0;
+		int end = dev->_width - 1;
+		if (pipe->_shownValid) {
+			while (start <= end && shown[start] == frame[page][start]) start++;
+			if (start > end) continue;
+			while (shown[end] == frame[page][end]) end--;
+		}
+		_pipeline_send_page(dev, page, start, &frame[page][start], end - start + 1);
+		memcpy(&shown[start], &frame[page][start], end - start + 1);
+		portENTER_CRITICAL(&pipe->_statsLock);
+		pipe->_stats.pages++;
+		portEXIT_CRITICAL(&pipe->_statsLock);
+	}
+	pipe->_shownValid = true;
+}
+
+static void _pipeline_task(void * pvParameters)
+{
+	ssd1306_pipeline_t * pipe = (ssd1306_pipeline_t *)pvParameters;
+	while (__atomic_load_n(&pipe->_running, __ATOMIC_ACQUIRE)) {
+		uint32_t tail = pipe->_tail;
+		if (__atomic_load_n(&pipe->_head, __ATOMIC_ACQUIRE) == tail) {
+			int64_t start = esp_timer_get_time();
+			ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+			int64_t idle = esp_timer_get_time() - start;
+			portENTER_CRITICAL(&pipe->_statsLock);
+			pipe->_stats.idleTime += idle;
+			portEXIT_CRITICAL(&pipe->_statsLock);
+			continue;
+		}
+		int64_t start = esp_timer_get_time();
+		_pipeline_send(pipe, pipe->_frame[tail % SSD1306_PIPELINE_FRAMES]);
+		int64_t flush = esp_timer_get_time() - start;
+		portENTER_CRITICAL(&pipe->_statsLock);
+		pipe->_stats.flushTime += flush;
+		pipe->_stats.frames++;
+		portEXIT_CRITICAL(&pipe->_statsLock);
+		__atomic_store_n(&pipe->_tail, tail + 1, __ATOMIC_RELEASE);
+		xSemaphoreGive(pipe->_slotFree);
+	}
+	__atomic_store_n(&pipe->_task, NULL, __ATOMIC_RELEASE);
+	vTaskDelete(NULL);
+}
+
+// Start a flush task pinned to core. The drawing task renders to internal buffer
+// and queues frames with ssd1306_pipeline_submit. The flush task sends them in order.
+// I2C and SPI interrupts run on the core that called i2c_master_init or spi_master_init,
+// so call it from a task on the same core to keep all bus work off the drawing core.
+// core < 0 or a core the chip does not have : no affinity.
+bool ssd1306_pipeline_start(SSD1306_t * dev, ssd1306_pipeline_t * pipe, int core, UBaseType_t priority)
+{
+	memset(pipe, 0, sizeof(ssd1306_pipeline_t));
+	pipe->_dev = dev;
+	portMUX_INITIALIZE(&pipe->_statsLock);
+	// Static, so the semaphore needs no delete and can be given after the flush task stopped
+	pipe->_slotFree = xSemaphoreCreateBinaryStatic(&pipe->_slotFreeBuffer);
+	pipe->_running = true;
+	pipe->_renderStart = esp_timer_get_time();
+	BaseType_t _core = core;
+	if (core < 0 || core >= portNUM_PROCESSORS) _core = tskNO_AFFINITY;
+	if (xTaskCreatePinnedToCore(_pipeline_task, "SSD1306", 1024*3, pipe, priority, &pipe->_task, _core) != pdPASS) {
+		ESP_LOGE(TAG, "flush task can not be created");
+		pipe->_running = false;
+		return false;
+	}
+	return true;
+}
+
+// Stop the flush task. Frames still in the queue are not sent.
+void ssd1306_pipeline_stop(ssd1306_pipeline_t * pipe)
+{
+	TaskHandle_t task = __atomic_load_n(&pipe->_task, __ATOMIC_ACQUIRE);
+	if (task == NULL) return;
+	__atomic_store_n(&pipe->_running, false, __ATOMIC_RELEASE);
+	xTaskNotifyGive(task);
+	// Wake the drawing task waiting for a free slot
+	xSemaphoreGive(pipe->_slotFree);
+	while (__atomic_load_n(&pipe->_task, __ATOMIC_ACQUIRE) != NULL) vTaskDelay(1);
+}
+
+// Mark the start of drawing a frame for renderTime.
+// Without it, renderTime counts from the end of the last ssd1306_pipeline_submit.
+void ssd1306_pipeline_begin(ssd1306_pipeline_t * pipe)
+{
+	pipe->_renderStart = esp_timer_get_time();
+}
+
+// Queue internal buffer as the next frame. Call it only from one task.
+// wait = true : wait for a free slot when the queue is full. The frame is dropped if the pipeline stops meanwhile
+// wait = false : drop the frame when the queue is full
+// Returns false when the frame was dropped.
+bool ssd1306_pipeline_submit(ssd1306_pipeline_t * pipe, bool wait)
+{
+	SSD1306_t * dev = pipe->_dev;
+	TaskHandle_t task = __atomic_load_n(&pipe->_task, __ATOMIC_ACQUIRE);
+	if (task == NULL) return false;
+	int64_t start = esp_timer_get_time();
+	int64_t render = start - pipe->_renderStart;
+
+	uint32_t head = pipe->_head;
+	bool queued = true;
+	if (head - __atomic_load_n(&pipe->_tail, __ATOMIC_ACQUIRE) >= SSD1306_PIPELINE_FRAMES) {
+		if (wait) {
+			// _slotFree is given for each frame sent and by ssd1306_pipeline_stop.
+			// A give before the take is kept by the semaphore, so no wake is missed.
+			while (head - __atomic_load_n(&pipe->_tail, __ATOMIC_ACQUIRE) >= SSD1306_PIPELINE_FRAMES) {
+				if (!__atomic_load_n(&pipe->_running, __ATOMIC_ACQUIRE)) {
+					queued = false;
+					break;
+				}
+				xSemaphoreTake(pipe->_slotFree, portMAX_DELAY);
+			}
+		} else {
+			queued = false;
+		}
+	}
+	if (queued) {
+		uint8_t (*frame)[128] = pipe->_frame[head % SSD1306_PIPELINE_FRAMES];
+		for (int page=0; page<dev->_pages; page++) {
+			memcpy(frame[page], dev->_page[page]._segs, dev->_width);
+		}
+		__atomic_store_n(&pipe->_head, head + 1, __ATOMIC_RELEASE);
+		xTaskNotifyGive(task);
+	}
+
+	int64_t end = esp_timer_get_time();
+	portENTER_CRITICAL(&pipe->_statsLock);
+	pipe->_stats.renderTime += render;
+	pipe->_stats.submitTime += end - start;
+	if (!queued) pipe->_stats.dropped++;
+	portEXIT_CRITICAL(&pipe->_statsLock);
+	pipe->_renderStart = end;
+	return queued;
+}
+
+// Copy the time spent in each stage. The copy is taken at one point in time.
+void ssd1306_pipeline_stats(ssd1306_pipeline_t * pipe, ssd1306_pipeline_stats_t * stats)
+{
+	portENTER_CRITICAL(&pipe->_statsLock);
+	*stats = pipe->_stats;
+	portEXIT_CRITICAL(&pipe->_statsLock);
+}
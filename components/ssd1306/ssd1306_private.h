@@ -0,0 +1,31 @@
+#ifndef MAIN_SSD1306_PRIVATE_H_
+#define MAIN_SSD1306_PRIVATE_H_
+
+// Internals shared by the source files of the component. Not for applications.
+
+#include "ssd1306.h"
+
+// How a mask is applied to the bytes of a surface
+typedef enum {
+	SPAN_SET = 0,
+	SPAN_CLEAR = 1,
+	SPAN_XOR = 2
+} span_op_t;
+
+// Page format memory drawn by the span and blit primitives. Internal buffer and canvases are surfaces.
+typedef struct {
+	uint8_t * _base; // Column 0 of page 0
+	int _stride; // Bytes from a page to the next one
+	int _pages;
+	int _width;
+	int _height;
+	bool _flip; // Bits of each byte are stored reversed
+	SSD1306_t * _dev; // Changed pages are marked dirty when not NULL
+} ssd1306_surface_t;
+
+void _ssd1306_surface_span(const ssd1306_surface_t * surface, int x1, int y1, int x2, int y2, span_op_t op);
+void _ssd1306_surface_blit(const ssd1306_surface_t * surface, int xpos, int ypos, const uint8_t * images, int width, int height, bool invert, ssd1306_draw_mode_t mode);
+bool _ssd1306_lock_flush(SSD1306_t * dev, int page);
+void _ssd1306_string_image(const ssd1306_font_t * font, char * text, int text_len, uint8_t * image, int width);
+
+#endif /* MAIN_SSD1306_PRIVATE_H_ */
@@ -0,0 +1,352 @@
+#include <string.h>
+
+#include "esp_log.h"
+
+#include "ssd1306.h"
+
+#define TAG "SSD1306"
+
+// Segments of a character. bit0 = a (top), b, c, d (bottom), e, f, bit6 = g (middle)
+//  aaa
+// f   b
+//  ggg
+// e   c
+//  ddd
+static uint8_t _segment_bits(char ch)
+{
+	static const uint8_t digits[10] = {
+		0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F
+	};
+	static const uint8_t hex[6] = {
+		0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71 // A b C d E F
+	};
+	if (ch >= '0' && ch <= '9') return digits[ch - '0'];
+	if (ch >= 'A' && ch <= 'F') return hex[ch - 'A'];
+	if (ch >= 'a' && ch <= 'f') return hex[ch - 'a'];
+	switch (ch) {
+	case '-': return 0x40;
+	case '_': return 0x08;
+	case 'H': return 0x76;
+	case 'L': return 0x38;
+	case 'P': return 0x73;
+	case 'U': return 0x3E;
+	case 'o': return 0x5C;
+	case 'r': return 0x50;
+	case 'n': return 0x54;
+	}
+	return 0x00;
+}
+
+// Narrow characters drawn as dots
+static bool _segment_is_dot(char ch)
+{
+	return (ch == '.' || ch == ':');
+}
+
+static int _isqrt(int n)
+{
+	int r = 0;
+	while ((r + 1) * (r + 1) <= n) r++;
+	return r;
+}
+
+// Pixels cut from each side of a segment of thickness, d pixels from its tip.
+// SEGMENT_SEVEN makes pointed (hexagon) ends, SEGMENT_ROUND round ends.
+static int _segment_inset(const ssd1306_segment_t * segment, int d)
+{
+	int r = (segment->thickness - 1) / 2;
+	if (d >= r) return 0;
+	if (segment->style == SEGMENT_ROUND) {
+		return r - _isqrt(r * r - (r - d) * (r - d));
+	}
+	return r - d;
+}
+
+// Gap between the tips of two segments meeting at a corner.
+// An even thickness has no center pixel, so it needs one more.
+// Round ends are fatter near the tip, so they need a wider gap.
+static int _segment_gap(const ssd1306_segment_t * segment)
+{
+	int gap = 1 + (segment->thickness % 2 == 0);
+	if (segment->style == SEGMENT_ROUND) gap = gap + segment->thickness / 5;
+	return gap;
+}
+
+// Receives the spans of a segment. Spans are one pixel wide or one pixel high.
+typedef void (*segment_span_t)(void * ctx, int xpos, int ypos, int width, int height);
+
+// Walk segment number s of the digit at xpos, ypos.
+// Horizontal segments are walked column by column and vertical ones row by row,
+// so each segment is a few spans. Segments never overlap, so each can be drawn or erased alone.
+static void _segment_spans(const ssd1306_segment_t * segment, int xpos, int ypos, int s, segment_span_t span, void * ctx)
+{
+	int t = segment->thickness;
+	int c = (t - 1) / 2; // Center of a band from its first pixel
+	int gap = _segment_gap(segment);
+	int left = xpos;
+	int right = xpos + segment->width - t;
+	int top = ypos;
+	int middle = ypos + (segment->height - t) / 2;
+	int bottom = ypos + segment->height - t;
+
+	if (s == 0 || s == 3 || s == 6) {
+		// a, d, g
+		int band = (s == 0) ? top : ((s == 3) ? bottom : middle);
+		int x1 = left + c + gap;
+		int x2 = right + c - gap;
+		for (int x = x1; x <= x2; x++) {
+			int d = (x - x1 < x2 - x) ? x - x1 : x2 - x;
+			int inset = _segment_inset(segment, d);
+			span(ctx, x, band + inset, 1, t - 2 * inset);
+		}
+	} else {
+		// b, c, e, f
+		int band = (s == 1 || s == 2) ? right : left;
+		int y1 = ((s == 1 || s == 5) ? top : middle) + c + gap;
+		int y2 = ((s == 1 || s == 5) ? middle : bottom) + c - gap;
+		for (int y = y1; y <= y2; y++) {
+			int d = (y - y1 < y2 - y) ? y - y1 : y2 - y;
+			int inset = _segment_inset(segment, d);
+			span(ctx, band + inset, y, t - 2 * inset, 1);
+		}
+	}
+}
+
+typedef struct {
+	SSD1306_t * dev;
+	bool invert;
+} segment_device_t;
+
+static void _segment_device_span(void * ctx, int xpos, int ypos, int width, int height)
+{
+	segment_device_t * out = (segment_device_t *)ctx;
+	ssd1306_fill_rect(out->dev, xpos, ypos, width, height, out->invert);
+}
+
+typedef struct {
+	uint8_t * image;
+	int width;
+} segment_image_t;
+
+static void _segment_image_span(void * ctx, int xpos, int ypos, int width, int height)
+{
+	segment_image_t * out = (segment_image_t *)ctx;
+	for (int x = xpos; x < xpos + width; x++) {
+		for (int y = ypos; y < ypos + height; y++) {
+			out->image[(y / 8) * out->width + x] |= (1 << (y % 8));
+		}
+	}
+}
+
+// Draw segment number s of the digit at xpos, ypos.
+static void _segment_draw(SSD1306_t * dev, const ssd1306_segment_t * segment, int xpos, int ypos, int s, bool invert)
+{
+	segment_device_t out = { dev, invert };
+	_segment_spans(segment, xpos, ypos, s, _segment_device_span, &out);
+}
+
+// Draw '.' or ':' in a cell of thickness columns.
+static void _segment_dot(SSD1306_t * dev, const ssd1306_segment_t * segment, int xpos, int ypos, char ch, bool invert)
+{
+	int t = segment->thickness;
+	int r = (segment->style == SEGMENT_ROUND) ? t / 2 : 0;
+	ssd1306_fill_rect(dev, xpos, ypos, t, segment->height, !invert);
+	if (ch == '.') {
+		ssd1306_fill_round_rect(dev, xpos, ypos + segment->height - t, t, t, r, invert);
+	} else {
+		ssd1306_fill_round_rect(dev, xpos, ypos + segment->height / 3 - t / 2, t, t, r, invert);
+		ssd1306_fill_round_rect(dev, xpos, ypos + segment->height * 2 / 3 - t / 2, t, t, r, invert);
+	}
+}
+
+// Width of character in pixels without spacing
+static int _segment_cell(const ssd1306_segment_t * segment, char ch)
+{
+	return _segment_is_dot(ch) ? segment->thickness : segment->width;
+}
+
+// Set large seven segment characters to internal buffer. Not show it.
+// Digits, A-F and - _ H L P U o r n are drawn as segments, '.' and ':' as narrow dots.
+// old is the text drawn at the same position last time, or NULL.
+// Only segments that differ from old are drawn or erased, so a changing counter touches a few bytes.
+// With old NULL every segment is drawn or erased. Returns xpos after the text.
+// When '.' or ':' moved, the cells after it moved too, so the rect of both texts is cleared and all is drawn.
+int ssd1306_draw_segments(SSD1306_t * dev, const ssd1306_segment_t * segment, int xpos, int ypos, char * text, char * old, int text_len, bool invert)
+{
+	for (int i = 0; old != NULL && i < text_len; i++) {
+		if (_segment_is_dot(old[i]) == _segment_is_dot(text[i])) continue;
+		int width = ssd1306_segments_width(segment, text, text_len);
+		int oldWidth = ssd1306_segments_width(segment, old, text_len);
+		if (oldWidth > width) width = oldWidth;
+		ssd1306_fill_rect(dev, xpos, ypos, width, segment->height, !invert);
+		old = NULL;
+	}
+	for (int i = 0; i < text_len; i++) {
+		char ch = text[i];
+		bool full = (old == NULL || _segment_is_dot(old[i]) != _segment_is_dot(ch));
+		if (_segment_is_dot(ch)) {
+			if (full || old[i] != ch) _segment_dot(dev, segment, xpos, ypos, ch, invert);
+		} else {
+			uint8_t bits = _segment_bits(ch);
+			uint8_t changed;
+			if (full) {
+				ssd1306_fill_rect(dev, xpos, ypos, segment->width, segment->height, !invert);
+				changed = bits;
+			} else {
+				changed = bits ^ _segment_bits(old[i]);
+			}
+			for (int s = 0; s < 7; s++) {
+				if ((changed & (1 << s)) == 0) continue;
+				bool on = (bits & (1 << s)) != 0;
+				_segment_draw(dev, segment, xpos, ypos, s, on ? invert : !invert);
+			}
+		}
+		xpos = xpos + _segment_cell(segment, ch) + segment->spacing;
+	}
+	return xpos;
+}
+
+// Width of text drawn by ssd1306_draw_segments in pixels.
+int ssd1306_segments_width(const ssd1306_segment_t * segment, char * text, int text_len)
+{
+	int width = 0;
+	for (int i = 0; i < text_len; i++) {
+		width = width + _segment_cell(segment, text[i]) + segment->spacing;
+	}
+	if (text_len > 0) width = width - segment->spacing;
+	return width;
+}
+
+// Render a seven segment character to a page format image like ssd1306_blit takes.
+// image is width * ((height + 7) / 8) bytes. '.' and ':' give a blank image.
+void ssd1306_segments_image(const ssd1306_segment_t * segment, char ch, uint8_t * image)
+{
+	memset(image, 0, segment->width * ((segment->height + 7) / 8));
+	if (_segment_is_dot(ch)) return;
+	segment_image_t out = { image, segment->width };
+	uint8_t bits = _segment_bits(ch);
+	for (int s = 0; s < 7; s++) {
+		if (bits & (1 << s)) _segment_spans(segment, 0, 0, s, _segment_image_span, &out);
+	}
+}
+
+// Column x of a digit image as one word. Bit 0 is the top row.
+static uint64_t _odometer_column(ssd1306_odometer_t * odometer, int digit, int x)
+{
+	int pages = (odometer->_height + 7) / 8;
+	const uint8_t * image = &odometer->_glyphs[digit * odometer->_width * pages];
+	uint64_t word = 0;
+	for (int page = 0; page < pages; page++) {
+		word |= (uint64_t)image[page * odometer->_width + x] << (page * 8);
+	}
+	return word;
+}
+
+// Set the window of digit i to internal buffer and show it.
+// Each column is the lower part of the current digit followed by the upper part of the next one,
+// shifted as a word and masked into the pages. No other window is touched.
+static void _odometer_draw(ssd1306_odometer_t * odometer, int i)
+{
+	SSD1306_t * dev = odometer->_dev;
+	int height = odometer->_height;
+	int offset = odometer->_offset[i];
+	int value = odometer->_value[i];
+	int next = (value + 1) % 10;
+	uint64_t mask = (height == 64) ? ~(uint64_t)0 : (((uint64_t)1 << height) - 1);
+	int xpos = odometer->_xpos + i * (odometer->_width + odometer->_spacing);
+	int ypos = odometer->_ypos;
+	// Pages are rounded down, also above the panel
+	int startPage = (ypos >= 0) ? ypos / 8 : -((7 - ypos) / 8);
+	int endPage = (ypos + height - 1 >= 0) ? (ypos + height - 1) / 8 : -((8 - ypos - height) / 8);
+	if (startPage < 0) startPage = 0;
+	if (endPage >= dev->_pages) endPage = dev->_pages - 1;
+	if (startPage > endPage) return;
+
+	for (int x = 0; x < odometer->_width; x++) {
+		int seg = xpos + x;
+		if (seg < 0 || seg >= dev->_width) continue;
+		uint64_t word = _odometer_column(odometer, value, x);
+		if (offset > 0) {
+			word = (word >> offset) | (_odometer_column(odometer, next, x) << (height - offset));
+		}
+		if (odometer->_invert) word = ~word;
+		word &= mask;
+		for (int page = startPage; page <= endPage; page++) {
+			// Row of the window at bit 0 of this page
+			int row = page * 8 - ypos;
+			uint8_t bits = (row >= 0) ? (uint8_t)(word >> row) : (uint8_t)(word << -row);
+			uint8_t keep = (row >= 0) ? (uint8_t)(mask >> row) : (uint8_t)(mask << -row);
+			uint8_t wk = dev->_page[page]._segs[seg];
+			if (dev->_flip) wk = ssd1306_rotate_byte(wk);
+			wk = (wk & ~keep) | (bits & keep);
+			if (dev->_flip) wk = ssd1306_rotate_byte(wk);
+			dev->_page[page]._segs[seg] = wk;
+		}
+	}
+	ssd1306_show_window(dev, startPage, endPage, xpos, xpos + odometer->_width - 1);
+}
+
+// Start a rolling counter of digits at xpos, ypos and show 0.
+// glyphs are page format images of 0 to 9 of width x height, made by ssd1306_segments_image or
+// ssd1306::transpose. The odometer keeps a pointer to them.
+void ssd1306_odometer_init(SSD1306_t * dev, ssd1306_odometer_t * odometer, const uint8_t * glyphs, int width, int height, int spacing, int xpos, int ypos, int digits, bool invert)
+{
+	if (digits > SSD1306_ODOMETER_DIGITS) {
+		ESP_LOGW(TAG, "Odometer has %d digits. Up to %d", digits, SSD1306_ODOMETER_DIGITS);
+		digits = SSD1306_ODOMETER_DIGITS;
+	}
+	odometer->_digits = 0;
+	if (height < 1 || height > 64) {
+		// A column of a digit is one 64 bit word
+		ESP_LOGE(TAG, "Odometer height %d must be 1 to 64", height);
+		return;
+	}
+	odometer->_dev = dev;
+	odometer->_glyphs = glyphs;
+	odometer->_xpos = xpos;
+	odometer->_ypos = ypos;
+	odometer->_width = width;
+	odometer->_height = height;
+	odometer->_spacing = spacing;
+	odometer->_digits = digits;
+	odometer->_invert = invert;
+	for (int i = 0; i < digits; i++) {
+		odometer->_value[i] = 0;
+		odometer->_target[i] = 0;
+		odometer->_offset[i] = 0;
+		_odometer_draw(odometer, i);
+	}
+}
+
+// Set the value to roll to. Digits that differ start rolling up with ssd1306_odometer_step.
+void ssd1306_odometer_set(ssd1306_odometer_t * odometer, uint32_t value)
+{
+	for (int i = odometer->_digits - 1; i >= 0; i--) {
+		odometer->_target[i] = value % 10;
+		value = value / 10;
+	}
+}
+
+// Roll every moving digit up by rows pixels and show only the windows that moved.
+// A digit passes through each digit on the way, like a mechanical counter.
+// Returns true while some digit has not reached the value.
+bool ssd1306_odometer_step(ssd1306_odometer_t * odometer, int rows)
+{
+	bool rolling = false;
+	if (rows < 1) rows = 1;
+	for (int i = 0; i < odometer->_digits; i++) {
+		if (odometer->_value[i] == odometer->_target[i] && odometer->_offset[i] == 0) continue;
+		odometer->_offset[i] += rows;
+		while (odometer->_offset[i] >= odometer->_height) {
+			odometer->_offset[i] -= odometer->_height;
+			odometer->_value[i] = (odometer->_value[i] + 1) % 10;
+			if (odometer->_value[i] == odometer->_target[i]) {
+				odometer->_offset[i] = 0;
+				break;
+			}
+		}
+		_odometer_draw(odometer, i);
+		if (odometer->_value[i] != odometer->_target[i] || odometer->_offset[i] != 0) rolling = true;
+	}
+	return rolling;
+}
@@ -75,6 +75,7 @@ void spi_master_init(SSD1306_t * dev, int16_t GPIO_MOSI, int16_t GPIO_SCLK, int1
 	dev->_SPIHandle = handle;
 	dev->_address = SPIAddress;
 	dev->_flip = false;
+	dev->_lock = NULL;
 }
 
 
@@ -94,8 +95,7 @@ bool spi_master_write_byte(spi_device_handle_t SPIHandle, const uint8_t* Data, s
 
 bool spi_master_write_command(SSD1306_t * dev, uint8_t Command )
 {
-	static uint8_t CommandByte = 0;
-	CommandByte = Command;
+	uint8_t CommandByte = Command;
 	gpio_set_level( dev->_dc, SPI_Command_Mode );
 	return spi_master_write_byte( dev->_SPIHandle, &CommandByte, 1 );
 }
@@ -153,7 +153,7 @@ void spi_init(SSD1306_t * dev, int width, int height)
 }
 
 
-void spi_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width)
+void spi_display_image(SSD1306_t * dev, int page, int seg, const uint8_t * images, int width)
 {
 	if (page >= dev->_pages) return;
 	if (seg >= dev->_width) return;
@@ -167,6 +167,7 @@ void spi_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int
 		_page = (dev->_pages - page) - 1;
 	}
 
+	ssd1306_lock(dev);
 	// Set Lower Column Start Address for Page Addressing Mode
 	spi_master_write_command(dev, (0x00 + columLow));
 	// Set Higher Column Start Address for Page Addressing Mode
@@ -175,7 +176,7 @@ void spi_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int
 	spi_master_write_command(dev, 0xB0 | _page);
 
 	spi_master_write_data(dev, images, width);
-
+	ssd1306_unlock(dev);
 }
 
 void spi_contrast(SSD1306_t * dev, int contrast) {
@@ -183,72 +184,93 @@ void spi_contrast(SSD1306_t * dev, int contrast) {
 	if (contrast < 0x0) _contrast = 0;
 	if (contrast > 0xFF) _contrast = 0xFF;
 
+	ssd1306_lock(dev);
 	spi_master_write_command(dev, OLED_CMD_SET_CONTRAST);			// 81
 	spi_master_write_command(dev, _contrast);
+	ssd1306_unlock(dev);
 }
 
-void spi_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll)
+// config is in GDDRAM pages and rows. NULL stops scrolling and sets display start line 0.
+void spi_hardware_scroll(SSD1306_t * dev, const ssd1306_scroll_config_t * config)
 {
+	ssd1306_lock(dev);
+	// Scroll must be stopped before it is set
+	spi_master_write_command(dev, OLED_CMD_DEACTIVE_SCROLL);		// 2E
 
-	if (scroll == SCROLL_RIGHT) {
-		spi_master_write_command(dev, OLED_CMD_HORIZONTAL_RIGHT);	// 26
-		spi_master_write_command(dev, 0x00); // Dummy byte
-		spi_master_write_command(dev, 0x00); // Define start page address
-		spi_master_write_command(dev, 0x07); // Frame frequency
-		spi_master_write_command(dev, 0x07); // Define end page address
-		spi_master_write_command(dev, 0x00); //
-		spi_master_write_command(dev, 0xFF); //
-		spi_master_write_command(dev, OLED_CMD_ACTIVE_SCROLL);		// 2F
-	} 
-
-	if (scroll == SCROLL_LEFT) {
-		spi_master_write_command(dev, OLED_CMD_HORIZONTAL_LEFT);	// 27
-		spi_master_write_command(dev, 0x00); // Dummy byte
-		spi_master_write_command(dev, 0x00); // Define start page address
-		spi_master_write_command(dev, 0x07); // Frame frequency
-		spi_master_write_command(dev, 0x07); // Define end page address
-		spi_master_write_command(dev, 0x00); //
-		spi_master_write_command(dev, 0xFF); //
-		spi_master_write_command(dev, OLED_CMD_ACTIVE_SCROLL);		// 2F
-	} 
+	if (config == NULL) {
+		// Vertical scroll leaves the start line moved
+		spi_master_write_command(dev, OLED_CMD_SET_DISPLAY_START_LINE);	// 40
+	}
 
-	if (scroll == SCROLL_DOWN) {
-		spi_master_write_command(dev, OLED_CMD_CONTINUOUS_SCROLL);	// 29
+	if (config != NULL && config->vertical == 0) {
+		if (config->horizontal == SCROLL_LEFT) {
+			spi_master_write_command(dev, OLED_CMD_HORIZONTAL_LEFT);	// 27
+		} else {
+			spi_master_write_command(dev, OLED_CMD_HORIZONTAL_RIGHT);	// 26
+		}
 		spi_master_write_command(dev, 0x00); // Dummy byte
-		spi_master_write_command(dev, 0x00); // Define start page address
-		spi_master_write_command(dev, 0x07); // Frame frequency
-		//spi_master_write_command(dev, 0x01); // Define end page address
-		spi_master_write_command(dev, 0x00); // Define end page address
-		spi_master_write_command(dev, 0x3F); // Vertical scrolling offset
-
-		spi_master_write_command(dev, OLED_CMD_VERTICAL);			// A3
-		spi_master_write_command(dev, 0x00);
-		if (dev->_height == 64)
-			spi_master_write_command(dev, 0x40);
-		if (dev->_height == 32)
-			spi_master_write_command(dev, 0x20);
+		spi_master_write_command(dev, config->startPage); // Define start page address
+		spi_master_write_command(dev, config->frames); // Frame frequency
+		spi_master_write_command(dev, config->endPage); // Define end page address
+		if (config->start == 0 && config->end == dev->_width - 1) {
+			spi_master_write_command(dev, 0x00); //
+			spi_master_write_command(dev, 0xFF); //
+		} else {
+			spi_master_write_command(dev, config->start + CONFIG_OFFSETX); // Start column
+			spi_master_write_command(dev, config->end + CONFIG_OFFSETX); // End column
+		}
 		spi_master_write_command(dev, OLED_CMD_ACTIVE_SCROLL);		// 2F
 	}
 
-	if (scroll == SCROLL_UP) {
-		spi_master_write_command(dev, OLED_CMD_CONTINUOUS_SCROLL);	// 29
-		spi_master_write_command(dev, 0x00); // Dummy byte
-		spi_master_write_command(dev, 0x00); // Define start page address
-		spi_master_write_command(dev, 0x07); // Frame frequency
-		//spi_master_write_command(dev, 0x01); // Define end page address
-		spi_master_write_command(dev, 0x00); // Define end page address
-		spi_master_write_command(dev, 0x01); // Vertical scrolling offset
-
+	if (config != NULL && config->vertical != 0) {
 		spi_master_write_command(dev, OLED_CMD_VERTICAL);			// A3
-		spi_master_write_command(dev, 0x00);
-		if (dev->_height == 64)
-			spi_master_write_command(dev, 0x40);
-		if (dev->_height == 32)
-			spi_master_write_command(dev, 0x20);
+		spi_master_write_command(dev, config->areaTop);
+		spi_master_write_command(dev, config->areaRows);
+		if (config->horizontal == SCROLL_LEFT) {
+			spi_master_write_command(dev, OLED_CMD_CONTINUOUS_SCROLL_LEFT);	// 2A
+		} else {
+			spi_master_write_command(dev, OLED_CMD_CONTINUOUS_SCROLL);	// 29
+		}
+		spi_master_write_command(dev, config->horizontal == SCROLL_STOP ? 0x00 : 0x01); // Horizontal scroll
+		spi_master_write_command(dev, config->startPage); // Define start page address
+		spi_master_write_command(dev, config->frames); // Frame frequency
+		spi_master_write_command(dev, config->endPage); // Define end page address
+		spi_master_write_command(dev, config->vertical); // Vertical scrolling offset
 		spi_master_write_command(dev, OLED_CMD_ACTIVE_SCROLL);		// 2F
 	}
+	ssd1306_unlock(dev);
+}
 
-	if (scroll == SCROLL_STOP) {
-		spi_master_write_command(dev, OLED_CMD_DEACTIVE_SCROLL);	// 2E
+// Scroll GDDRAM of the window by one column. config is in GDDRAM pages.
+void spi_content_scroll(SSD1306_t * dev, const ssd1306_scroll_config_t * config)
+{
+	ssd1306_lock(dev);
+	if (config->horizontal == SCROLL_LEFT) {
+		spi_master_write_command(dev, OLED_CMD_CONTENT_SCROLL_LEFT);	// 2D
+	} else {
+		spi_master_write_command(dev, OLED_CMD_CONTENT_SCROLL_RIGHT);	// 2C
 	}
+	spi_master_write_command(dev, 0x00); // Dummy byte
+	spi_master_write_command(dev, config->startPage); // Define start page address
+	spi_master_write_command(dev, 0x01); // Dummy byte
+	spi_master_write_command(dev, config->endPage); // Define end page address
+	spi_master_write_command(dev, config->start + CONFIG_OFFSETX); // Start column
+	spi_master_write_command(dev, config->end + CONFIG_OFFSETX); // End column
+	ssd1306_unlock(dev);
+}
+
+void spi_hardware_zoom(SSD1306_t * dev, int line, bool enable)
+{
+	ssd1306_lock(dev);
+	spi_master_write_command(dev, OLED_CMD_SET_DISPLAY_START_LINE | (line & 0x3F));	// 40
+	spi_master_write_command(dev, OLED_CMD_SET_ZOOM);			// D6
+	spi_master_write_command(dev, enable ? 0x01 : 0x00);
+	ssd1306_unlock(dev);
+}
+
+void spi_display_start_line(SSD1306_t * dev, int line)
+{
+	ssd1306_lock(dev);
+	spi_master_write_command(dev, OLED_CMD_SET_DISPLAY_START_LINE | (line & 0x3F));	// 40
+	ssd1306_unlock(dev);
 }
@@ -0,0 +1,114 @@
+#include <string.h>
+
+#include "esp_log.h"
+
+#include "ssd1306.h"
+
+#define TAG "SSD1306"
+
+// _pending is the slot index with these flags
+#define SWAP_SLOT 0x0F
+#define SWAP_NEW 0x10 // Frame in the slot is not sent yet
+#define SWAP_WRITING 0x20 // SSD1306_SWAP_SHARED: the slot of the latest frame is being written
+#define SWAP_SENDING 0x40 // SSD1306_SWAP_SHARED: a slot is being sent
+
+// Start a swap chain on dev. buffers is SSD1306_SWAP_SHARED or SSD1306_SWAP_LATEST.
+// Draw into internal buffer as usual and hand the frame over with ssd1306_swap_present.
+// Another task sends the latest frame with ssd1306_swap_flush.
+// The chain is about 3 KB, so do not put it on a small stack.
+void ssd1306_swap_init(SSD1306_t * dev, ssd1306_swap_t * swap, int buffers)
+{
+	if (buffers != SSD1306_SWAP_SHARED && buffers != SSD1306_SWAP_LATEST) {
+		ESP_LOGW(TAG, "swap chain mode %d. SSD1306_SWAP_LATEST is used", buffers);
+		buffers = SSD1306_SWAP_LATEST;
+	}
+	memset(swap, 0, sizeof(ssd1306_swap_t));
+	swap->_dev = dev;
+	swap->_buffers = buffers;
+	if (buffers == SSD1306_SWAP_LATEST) {
+		swap->_front = 0;
+		swap->_pending = 1;
+		swap->_back = 2;
+	}
+}
+
+// Copy internal buffer to the chain as the latest frame. Never waits for the bus.
+// A frame not sent yet is replaced, so the sender always gets the latest frame.
+// With SSD1306_SWAP_LATEST the frame is written to a free slot of three.
+// With SSD1306_SWAP_SHARED the frame is written to the slot not being sent.
+// Returns true. Replaced frames are counted in _dropped.
+bool ssd1306_swap_present(ssd1306_swap_t * swap)
+{
+	SSD1306_t * dev = swap->_dev;
+	if (swap->_buffers == SSD1306_SWAP_LATEST) {
+		for (int page=0; page<dev->_pages; page++) {
+			memcpy(swap->_frame[swap->_back][page], dev->_page[page]._segs, dev->_width);
+		}
+		uint32_t old = __atomic_exchange_n(&swap->_pending, swap->_back | SWAP_NEW, __ATOMIC_ACQ_REL);
+		if (old & SWAP_NEW) __atomic_fetch_add(&swap->_dropped, 1, __ATOMIC_RELAXED);
+		swap->_back = old & SWAP_SLOT;
+		return true;
+	}
+
+	// Two slots. While a slot is sent and a new frame waits in the other one, the waiting frame is
+	// replaced in place, so that slot is marked SWAP_WRITING and ssd1306_swap_flush does not take it.
+	// Otherwise the slot other than the latest one is written. It is never sent before it is handed over.
+	uint32_t old = __atomic_load_n(&swap->_pending, __ATOMIC_ACQUIRE);
+	int slot;
+	for (;;) {
+		if ((old & SWAP_SENDING) == 0 || (old & SWAP_NEW) == 0) {
+			slot = (old & SWAP_SLOT) ^ 1;
+			break;
+		}
+		// Fails when the send ended and the waiting frame was taken meanwhile
+		if (__atomic_compare_exchange_n(&swap->_pending, &old, old | SWAP_WRITING, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+			slot = old & SWAP_SLOT;
+			break;
+		}
+	}
+	for (int page=0; page<dev->_pages; page++) {
+		memcpy(swap->_frame[slot][page], dev->_page[page]._segs, dev->_width);
+	}
+	// Keep SWAP_SENDING, which ssd1306_swap_flush may change meanwhile
+	old = __atomic_load_n(&swap->_pending, __ATOMIC_ACQUIRE);
+	while (!__atomic_compare_exchange_n(&swap->_pending, &old, slot | SWAP_NEW | (old & SWAP_SENDING), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+	}
+	if (old & SWAP_NEW) __atomic_fetch_add(&swap->_dropped, 1, __ATOMIC_RELAXED);
+	return true;
+}
+
+static void _swap_send(SSD1306_t * dev, uint8_t frame[8][128])
+{
+	for (int page=0; page<dev->_pages; page++) {
+		ssd1306_lock_region(dev, page, page);
+		if (dev->_address == SPIAddress) {
+			spi_display_image(dev, page, 0, frame[page], dev->_width);
+		} else {
+			i2c_display_image(dev, page, 0, frame[page], dev->_width);
+		}
+		ssd1306_unlock_region(dev, page, page);
+	}
+}
+
+// Send the latest frame if there is a new one. Call it from the task that owns the bus.
+// Returns false when there was no new frame, or with SSD1306_SWAP_SHARED when it was still being written.
+bool ssd1306_swap_flush(ssd1306_swap_t * swap)
+{
+	SSD1306_t * dev = swap->_dev;
+	if (swap->_buffers == SSD1306_SWAP_LATEST) {
+		if ((__atomic_load_n(&swap->_pending, __ATOMIC_ACQUIRE) & SWAP_NEW) == 0) return false;
+		uint32_t old = __atomic_exchange_n(&swap->_pending, swap->_front, __ATOMIC_ACQ_REL);
+		swap->_front = old & SWAP_SLOT;
+		_swap_send(dev, swap->_frame[swap->_front]);
+		return true;
+	}
+
+	// Take the latest frame unless it is being written. A frame presented meanwhile goes to the other slot.
+	uint32_t old = __atomic_load_n(&swap->_pending, __ATOMIC_ACQUIRE);
+	if ((old & SWAP_NEW) == 0 || (old & SWAP_WRITING)) return false;
+	if (!__atomic_compare_exchange_n(&swap->_pending, &old, (old & SWAP_SLOT) | SWAP_SENDING, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) return false;
+	swap->_front = old & SWAP_SLOT;
+	_swap_send(dev, swap->_frame[swap->_front]);
+	__atomic_fetch_and(&swap->_pending, ~SWAP_SENDING, __ATOMIC_ACQ_REL);
+	return true;
+}
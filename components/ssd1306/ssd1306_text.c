@@ -0,0 +1,996 @@
+#include <string.h>
+
+#include "esp_log.h"
+
+#include "ssd1306.h"
+#include "ssd1306_private.h"
+#include "font8x8_basic.h"
+
+#define TAG "SSD1306"
+
+// Glyph of 8x8 font. Characters outside of the font are shown as space.
+static const uint8_t * _font8x8_glyph(char ch)
+{
+	uint8_t code = (uint8_t)ch;
+	if (code >= 128) code = ' ';
+	return font8x8_basic_tr[code];
+}
+
+// Set text to internal buffer at any position. Not show it.
+// Text is clipped by the panel. Changed area is marked dirty, so show it with ssd1306_show_dirty.
+void ssd1306_draw_text(SSD1306_t * dev, int xpos, int ypos, char * text, int text_len, bool invert, ssd1306_draw_mode_t mode)
+{
+	for (int i=0; i<text_len; i++) {
+		if (xpos >= dev->_width) break;
+		if (xpos > -8) {
+			ssd1306_blit(dev, xpos, ypos, _font8x8_glyph(text[i]), 8, 8, invert, mode);
+		}
+		xpos = xpos + 8;
+	}
+}
+
+// Decode one UTF-8 character from text[*pos] and advance *pos.
+// Invalid or truncated sequences are decoded as U+FFFD one byte at a time.
+static uint32_t _utf8_next(char * text, int text_len, int * pos)
+{
+	const uint8_t * p = (const uint8_t *)&text[*pos];
+	int remain = text_len - *pos;
+	uint32_t code;
+	int len;
+	if (p[0] < 0x80) {
+		*pos = *pos + 1;
+		return p[0];
+	} else if ((p[0] & 0xE0) == 0xC0) {
+		code = p[0] & 0x1F;
+		len = 2;
+	} else if ((p[0] & 0xF0) == 0xE0) {
+		code = p[0] & 0x0F;
+		len = 3;
+	} else if ((p[0] & 0xF8) == 0xF0) {
+		code = p[0] & 0x07;
+		len = 4;
+	} else {
+		*pos = *pos + 1;
+		return 0xFFFD;
+	}
+	if (remain < len) {
+		*pos = *pos + 1;
+		return 0xFFFD;
+	}
+	for (int i=1; i<len; i++) {
+		if ((p[i] & 0xC0) != 0x80) {
+			*pos = *pos + 1;
+			return 0xFFFD;
+		}
+		code = (code << 6) | (p[i] & 0x3F);
+	}
+	*pos = *pos + len;
+	return code;
+}
+
+// Glyph of code. NULL when the font doesn't have it.
+// Sparse fonts have sorted ranges of code points, so use binary search.
+static const ssd1306_glyph_t * _font_glyph(const ssd1306_font_t * font, uint32_t code)
+{
+	if (font->ranges == NULL) {
+		if (code < font->first || code > font->last) return NULL;
+		return &font->glyphs[code - font->first];
+	}
+	int lo = 0;
+	int hi = font->rangeLen - 1;
+	while (lo <= hi) {
+		int mid = (lo + hi) / 2;
+		const ssd1306_range_t * range = &font->ranges[mid];
+		if (code < range->first) {
+			hi = mid - 1;
+		} else if (code > range->last) {
+			lo = mid + 1;
+		} else {
+			return &font->glyphs[range->index + (code - range->first)];
+		}
+	}
+	return NULL;
+}
+
+// Glyph of code, or '?' when the font doesn't have it.
+// A glyph of no width and no advance is a hole left by older converters, so it is missing too.
+static const ssd1306_glyph_t * _font_glyph_or_default(const ssd1306_font_t * font, uint32_t code)
+{
+	const ssd1306_glyph_t * glyph = _font_glyph(font, code);
+	if (glyph != NULL && glyph->width == 0 && glyph->advance == 0) glyph = NULL;
+	if (glyph == NULL) glyph = _font_glyph(font, '?');
+	return glyph;
+}
+
+// Kerning of the pair. Pairs are sorted, so use binary search.
+static int _font_kerning(const ssd1306_font_t * font, uint32_t first, uint32_t second)
+{
+	if (font->kerning == NULL) return 0;
+	if (first > 0xFFFF || second > 0xFFFF) return 0;
+	int lo = 0;
+	int hi = font->kerningLen - 1;
+	uint32_t key = (first << 16) | second;
+	while (lo <= hi) {
+		int mid = (lo + hi) / 2;
+		const ssd1306_kern_t * kern = &font->kerning[mid];
+		uint32_t wk = ((uint32_t)kern->first << 16) | kern->second;
+		if (wk == key) return kern->adjust;
+		if (wk < key) {
+			lo = mid + 1;
+		} else {
+			hi = mid - 1;
+		}
+	}
+	return 0;
+}
+
+// Width of UTF-8 text in pixels when drawn by font.
+int ssd1306_string_width(const ssd1306_font_t * font, char * text, int text_len)
+{
+	int width = 0;
+	if (text_len <= 0) return width;
+	int pos = 0;
+	uint32_t next = _utf8_next(text, text_len, &pos);
+	while (1) {
+		uint32_t code = next;
+		bool last = (pos >= text_len);
+		if (!last) next = _utf8_next(text, text_len, &pos);
+		const ssd1306_glyph_t * glyph = _font_glyph_or_default(font, code);
+		if (glyph != NULL) {
+			width = width + glyph->advance;
+			if (!last) width = width + _font_kerning(font, code, next);
+		}
+		if (last) break;
+	}
+	return width;
+}
+
+// Render UTF-8 text drawn by font to image of width * ((font->height + 7) / 8) bytes.
+// width is ssd1306_string_width of the text. Glyphs are ORed, so kerned glyphs can overlap.
+void _ssd1306_string_image(const ssd1306_font_t * font, char * text, int text_len, uint8_t * image, int width)
+{
+	int pages = (font->height + 7) / 8;
+	memset(image, 0, width * pages);
+	if (text_len <= 0) return;
+	int xpos = 0;
+	int pos = 0;
+	uint32_t next = _utf8_next(text, text_len, &pos);
+	while (1) {
+		uint32_t code = next;
+		bool last = (pos >= text_len);
+		if (!last) next = _utf8_next(text, text_len, &pos);
+		const ssd1306_glyph_t * glyph = _font_glyph_or_default(font, code);
+		if (glyph != NULL) {
+			const uint8_t * bitmap = &font->bitmap[glyph->offset];
+			for (int col = 0; col < glyph->width; col++) {
+				int x = xpos + glyph->left + col;
+				if (x < 0 || x >= width) continue;
+				for (int page = 0; page < pages; page++) {
+					image[page * width + x] |= bitmap[page * glyph->width + col];
+				}
+			}
+			xpos = xpos + glyph->advance;
+			if (!last) xpos = xpos + _font_kerning(font, code, next);
+		}
+		if (last) break;
+	}
+}
+
+// Set UTF-8 text of proportional font to internal buffer at any position. Not show it.
+// ypos is the top of the glyphs. Returns xpos after the text.
+// In DRAW_COPY mode the background of the whole string is also drawn.
+// It is cleared once and the glyphs are ORed on it, then inverted once when invert.
+int ssd1306_draw_string(SSD1306_t * dev, const ssd1306_font_t * font, int xpos, int ypos, char * text, int text_len, bool invert, ssd1306_draw_mode_t mode)
+{
+	if (text_len <= 0) return xpos;
+	int left = xpos;
+	bool copy = (mode == DRAW_COPY);
+	if (copy) {
+		ssd1306_fill_rect(dev, xpos, ypos, ssd1306_string_width(font, text, text_len), font->height, true);
+		mode = DRAW_OR;
+	}
+	int pos = 0;
+	uint32_t next = _utf8_next(text, text_len, &pos);
+	while (1) {
+		uint32_t code = next;
+		bool last = (pos >= text_len);
+		if (!last) next = _utf8_next(text, text_len, &pos);
+		const ssd1306_glyph_t * glyph = _font_glyph_or_default(font, code);
+		if (glyph != NULL) {
+			int advance = glyph->advance;
+			if (!last) advance = advance + _font_kerning(font, code, next);
+			if (xpos < dev->_width && glyph->width != 0 && xpos + glyph->left + glyph->width > 0) {
+				const uint8_t * images = &font->bitmap[glyph->offset];
+				ssd1306_blit(dev, xpos + glyph->left, ypos, images, glyph->width, font->height, invert && !copy, mode);
+			}
+			xpos = xpos + advance;
+		}
+		if (last) break;
+	}
+	if (copy && invert) ssd1306_invert_rect(dev, left, ypos, xpos - left, font->height);
+	return xpos;
+}
+
+// One line of text laid out in a box
+typedef struct {
+	int start; // First byte of the line in text
+	int len; // Bytes of the line
+	int width; // Width of the line in pixels
+	int next; // First byte of the next line
+} text_line_t;
+
+// Next character of text. UTF-8 for proportional font, one byte for 8x8 font.
+static uint32_t _layout_next(const ssd1306_font_t * font, char * text, int text_len, int * pos)
+{
+	if (font == NULL) {
+		uint8_t code = (uint8_t)text[*pos];
+		*pos = *pos + 1;
+		return code;
+	}
+	return _utf8_next(text, text_len, pos);
+}
+
+// Width added to the line by code following prev. prev is 0 at the start of line.
+static int _layout_advance(const ssd1306_font_t * font, uint32_t prev, uint32_t code)
+{
+	if (font == NULL) return 8;
+	const ssd1306_glyph_t * glyph = _font_glyph_or_default(font, code);
+	if (glyph == NULL) return 0;
+	int advance = glyph->advance;
+	if (prev != 0) advance = advance + _font_kerning(font, prev, code);
+	return advance;
+}
+
+// Lay out one line of text from pos in width pixels.
+// A line always has at least one character, so layout goes forward even in a narrow box.
+static void _layout_line(const ssd1306_font_t * font, char * text, int text_len, int pos, int width, ssd1306_wrap_t wrap, text_line_t * line)
+{
+	line->start = pos;
+	line->len = 0;
+	line->width = 0;
+	line->next = text_len;
+
+	int lineWidth = 0;
+	int breakEnd = -1; // End of the line when broken at the last space
+	int breakWidth = 0;
+	int breakNext = 0;
+	bool cut = false; // WRAP_NONE: rest of the line is not shown
+	uint32_t prev = 0;
+	while (pos < text_len) {
+		int at = pos;
+		uint32_t code = _layout_next(font, text, text_len, &pos);
+		if (code == '\n') {
+			line->next = pos;
+			break;
+		}
+		if (cut) continue;
+		if (code == ' ' && wrap == WRAP_WORD) {
+			if (at > line->start && prev != ' ') {
+				breakEnd = at;
+				breakWidth = lineWidth;
+			}
+			breakNext = pos;
+		}
+		int advance = _layout_advance(font, prev, code);
+		if (lineWidth + advance > width && at > line->start) {
+			if (wrap == WRAP_NONE) {
+				cut = true;
+				continue;
+			}
+			if (wrap == WRAP_WORD && breakEnd >= 0) {
+				line->len = breakEnd - line->start;
+				line->width = breakWidth;
+				line->next = breakNext;
+			} else {
+				line->len = at - line->start;
+				line->width = lineWidth;
+				line->next = at;
+			}
+			// Spaces at the wrap point are not shown on the next line
+			while (line->next < text_len && text[line->next] == ' ') line->next++;
+			return;
+		}
+		lineWidth = lineWidth + advance;
+		line->len = pos - line->start;
+		line->width = lineWidth;
+		prev = code;
+	}
+	if (pos >= text_len) line->next = text_len;
+	// Spaces at the end of the line don't count for alignment
+	while (line->len > 0 && text[line->start + line->len - 1] == ' ') {
+		line->len--;
+		line->width = line->width - _layout_advance(font, 0, ' ');
+	}
+}
+
+// Measure text laid out in a box width pixels wide. Nothing is drawn.
+// font NULL means 8x8 font. Returns the height of all lines in pixels.
+// The width of the widest line is set to text_width unless it is NULL.
+int ssd1306_measure_text(const ssd1306_font_t * font, int width, char * text, int text_len, ssd1306_wrap_t wrap, int * text_width)
+{
+	int lineHeight = (font == NULL) ? 8 : font->height;
+	int height = 0;
+	int maxWidth = 0;
+	int pos = 0;
+	while (pos < text_len) {
+		text_line_t line;
+		_layout_line(font, text, text_len, pos, width, wrap, &line);
+		if (line.width > maxWidth) maxWidth = line.width;
+		height = height + lineHeight;
+		pos = line.next;
+	}
+	if (text_width != NULL) *text_width = maxWidth;
+	return height;
+}
+
+// Set text laid out in a box to internal buffer. Not show it.
+// font NULL means 8x8 font. The box is cleared first and only whole lines are drawn.
+// Changed area is marked dirty, so the box is shown by one ssd1306_show_dirty.
+// Returns the bytes of text drawn. Less than text_len means the rest didn't fit the box.
+int ssd1306_draw_text_box(SSD1306_t * dev, const ssd1306_font_t * font, int xpos, int ypos, int width, int height, char * text, int text_len, ssd1306_align_t align, ssd1306_wrap_t wrap, bool invert)
+{
+	int lineHeight = (font == NULL) ? 8 : font->height;
+	ssd1306_fill_rect(dev, xpos, ypos, width, height, !invert);
+
+	int pos = 0;
+	int _ypos = ypos;
+	while (pos < text_len && _ypos + lineHeight <= ypos + height) {
+		text_line_t line;
+		_layout_line(font, text, text_len, pos, width, wrap, &line);
+		int _xpos = xpos;
+		if (align == ALIGN_CENTER) _xpos = xpos + (width - line.width) / 2;
+		if (align == ALIGN_RIGHT) _xpos = xpos + width - line.width;
+		if (line.len > 0) {
+			if (font == NULL) {
+				ssd1306_draw_text(dev, _xpos, _ypos, &text[line.start], line.len, invert, DRAW_COPY);
+			} else {
+				ssd1306_draw_string(dev, font, _xpos, _ypos, &text[line.start], line.len, invert, DRAW_COPY);
+			}
+		}
+		_ypos = _ypos + lineHeight;
+		pos = line.next;
+	}
+	return pos;
+}
+
+// Output of ssd1306_printf. Characters are drawn as soon as they are formatted.
+typedef struct {
+	SSD1306_t * dev;
+	ssd1306_terminal_t * term; // Characters go to the terminal when not NULL
+	const ssd1306_font_t * font; // NULL means 8x8 font
+	bool invert;
+	int cell; // Width of tabular cells of numeric fields. 0 means font spacing
+	uint32_t prev; // Previous character for kerning. 0 at the start of line
+	uint8_t utf8[4]; // Incomplete UTF-8 sequence
+	int utf8Len;
+	int count; // Bytes formatted
+} printf_t;
+
+// Draw one character cell at the cursor and advance the cursor.
+// Columns of the cell not covered by the glyph are cleared, so text can be redrawn in place.
+static void _printf_cell(printf_t * pf, const uint8_t * images, int width, int left, int advance)
+{
+	SSD1306_t * dev = pf->dev;
+	int height = (pf->font == NULL) ? 8 : pf->font->height;
+	int xpos = dev->_cursorX;
+	if (xpos < dev->_width && xpos + advance > 0) {
+		ssd1306_fill_rect(dev, xpos, dev->_cursorY, left, height, !pf->invert);
+		ssd1306_fill_rect(dev, xpos + left + width, dev->_cursorY, advance - left - width, height, !pf->invert);
+		if (width != 0) {
+			ssd1306_blit(dev, xpos + left, dev->_cursorY, images, width, height, pf->invert, DRAW_COPY);
+		}
+	}
+	dev->_cursorX = xpos + advance;
+}
+
+static void _terminal_code(ssd1306_terminal_t * term, uint32_t code);
+
+static void _printf_code(printf_t * pf, uint32_t code)
+{
+	if (pf->term != NULL) {
+		_terminal_code(pf->term, code);
+		return;
+	}
+	SSD1306_t * dev = pf->dev;
+	if (code == '\n') {
+		dev->_cursorX = dev->_cursorLeft;
+		dev->_cursorY = dev->_cursorY + ((pf->font == NULL) ? 8 : pf->font->height);
+		pf->prev = 0;
+		return;
+	}
+	if (pf->font == NULL) {
+		int advance = (pf->cell != 0) ? pf->cell : 8;
+		_printf_cell(pf, _font8x8_glyph((char)code), 8, (advance - 8) / 2, advance);
+		return;
+	}
+	const ssd1306_glyph_t * glyph = _font_glyph_or_default(pf->font, code);
+	if (glyph == NULL) return;
+	const uint8_t * images = &pf->font->bitmap[glyph->offset];
+	if (pf->cell != 0) {
+		_printf_cell(pf, images, glyph->width, (pf->cell - glyph->width) / 2, pf->cell);
+		pf->prev = 0;
+		return;
+	}
+	if (pf->prev != 0) dev->_cursorX = dev->_cursorX + _font_kerning(pf->font, pf->prev, code);
+	_printf_cell(pf, images, glyph->width, glyph->left, glyph->advance);
+	pf->prev = code;
+}
+
+// Take one formatted byte. UTF-8 sequences are collected until complete.
+static void _printf_byte(printf_t * pf, uint8_t ch)
+{
+	pf->count++;
+	if (pf->font == NULL) {
+		_printf_code(pf, ch);
+		return;
+	}
+	if (pf->utf8Len > 0 && (ch & 0xC0) != 0x80) {
+		// Broken sequence
+		pf->utf8Len = 0;
+		_printf_code(pf, 0xFFFD);
+	}
+	if (pf->utf8Len == 0 && ch < 0x80) {
+		_printf_code(pf, ch);
+		return;
+	}
+	pf->utf8[pf->utf8Len++] = ch;
+	int need = 1;
+	if ((pf->utf8[0] & 0xE0) == 0xC0) need = 2;
+	if ((pf->utf8[0] & 0xF0) == 0xE0) need = 3;
+	if ((pf->utf8[0] & 0xF8) == 0xF0) need = 4;
+	if (pf->utf8Len < need) return;
+	int pos = 0;
+	uint32_t code = _utf8_next((char *)pf->utf8, pf->utf8Len, &pos);
+	pf->utf8Len = 0;
+	_printf_code(pf, code);
+}
+
+static void _printf_repeat(printf_t * pf, char ch, int count)
+{
+	for (int i = 0; i < count; i++) _printf_byte(pf, ch);
+}
+
+// Number of digits of value in base
+static int _printf_digits(unsigned long long value, unsigned base)
+{
+	int digits = 1;
+	while (value >= base) {
+		value = value / base;
+		digits++;
+	}
+	return digits;
+}
+
+// Digits of value from the most significant one, without a buffer.
+static void _printf_number(printf_t * pf, unsigned long long value, unsigned base, int digits, bool upper)
+{
+	const char * hex = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+	unsigned long long divisor = 1;
+	for (int i = 1; i < digits; i++) divisor = divisor * base;
+	for (int i = 0; i < digits; i++) {
+		_printf_byte(pf, hex[(value / divisor) % base]);
+		divisor = divisor / base;
+	}
+}
+
+// Pad, sign and digits of a numeric field.
+// Fields with width are drawn in cells of the width of '0', so the field keeps its place when the value changes.
+static void _printf_field(printf_t * pf, char sign, unsigned long long value, unsigned base, bool upper, int fraction, int fracDigits, int width, bool left, bool zero)
+{
+	int digits = _printf_digits(value, base);
+	int len = digits + (sign ? 1 : 0) + ((fracDigits > 0) ? fracDigits + 1 : 0);
+	int pad = (width > len) ? width - len : 0;
+
+	if (width > 0) {
+		if (pf->font == NULL) {
+			pf->cell = 8;
+		} else {
+			const ssd1306_glyph_t * glyph = _font_glyph_or_default(pf->font, '0');
+			pf->cell = (glyph != NULL) ? glyph->advance : 0;
+		}
+	}
+	if (!left && !zero) _printf_repeat(pf, ' ', pad);
+	if (sign) _printf_byte(pf, sign);
+	if (!left && zero) _printf_repeat(pf, '0', pad);
+	_printf_number(pf, value, base, digits, upper);
+	if (fracDigits > 0) {
+		_printf_byte(pf, '.');
+		_printf_number(pf, fraction, 10, fracDigits, false);
+	}
+	if (left) _printf_repeat(pf, ' ', pad);
+	pf->cell = 0;
+}
+
+// Format text and pass each character to the output of pf.
+static int _printf_format(printf_t * pf, const char * format, va_list args)
+{
+	for (const char * p = format; *p != '\0'; p++) {
+		if (*p != '%') {
+			_printf_byte(pf, *p);
+			continue;
+		}
+		p++;
+		bool left = false;
+		bool zero = false;
+		char plus = 0;
+		while (*p == '-' || *p == '0' || *p == '+' || *p == ' ') {
+			if (*p == '-') left = true;
+			if (*p == '0') zero = true;
+			if (*p == '+') plus = '+';
+			if (*p == ' ' && plus == 0) plus = ' ';
+			p++;
+		}
+		int width = 0;
+		if (*p == '*') {
+			width = va_arg(args, int);
+			if (width < 0) {
+				// Negative width is - flag
+				left = true;
+				width = -width;
+			}
+			p++;
+		}
+		while (*p >= '0' && *p <= '9') width = width * 10 + (*p++ - '0');
+		int precision = -1;
+		if (*p == '.') {
+			p++;
+			precision = 0;
+			while (*p >= '0' && *p <= '9') precision = precision * 10 + (*p++ - '0');
+		}
+		int length = 0;
+		while (*p == 'l') {
+			length++;
+			p++;
+		}
+		while (*p == 'h' || *p == 'z') p++;
+		if (*p == '\0') break;
+
+		if (*p == 'd' || *p == 'i') {
+			long long value;
+			if (length >= 2) value = va_arg(args, long long);
+			else if (length == 1) value = va_arg(args, long);
+			else value = va_arg(args, int);
+			char sign = (value < 0) ? '-' : plus;
+			unsigned long long magnitude = (value < 0) ? -(unsigned long long)value : (unsigned long long)value;
+			_printf_field(pf, sign, magnitude, 10, false, 0, 0, width, left, zero);
+		} else if (*p == 'u' || *p == 'x' || *p == 'X' || *p == 'o') {
+			unsigned long long value;
+			if (length >= 2) value = va_arg(args, unsigned long long);
+			else if (length == 1) value = va_arg(args, unsigned long);
+			else value = va_arg(args, unsigned int);
+			unsigned base = (*p == 'u') ? 10 : (*p == 'o') ? 8 : 16;
+			_printf_field(pf, 0, value, base, *p == 'X', 0, 0, width, left, zero);
+		} else if (*p == 'p') {
+			uintptr_t value = (uintptr_t)va_arg(args, void *);
+			_printf_byte(pf, '0');
+			_printf_byte(pf, 'x');
+			_printf_field(pf, 0, value, 16, false, 0, 0, 0, false, false);
+		} else if (*p == 'f' || *p == 'F' || *p == 'e' || *p == 'E' || *p == 'g' || *p == 'G') {
+			// %e and %g are drawn as %f
+			double value = va_arg(args, double);
+			if (precision < 0) precision = 6;
+			if (precision > 9) precision = 9;
+			char sign = (value < 0) ? '-' : plus;
+			if (value < 0) value = -value;
+			if (value != value || value >= 1e19) {
+				// NaN or too large
+				const char * word = (value != value) ? "nan" : "inf";
+				if (!left) _printf_repeat(pf, ' ', width - 3 - (sign ? 1 : 0));
+				if (sign) _printf_byte(pf, sign);
+				for (int i = 0; i < 3; i++) _printf_byte(pf, word[i]);
+				if (left) _printf_repeat(pf, ' ', width - 3 - (sign ? 1 : 0));
+				continue;
+			}
+			unsigned long scale = 1;
+			for (int i = 0; i < precision; i++) scale = scale * 10;
+			value = value + 0.5 / scale;
+			unsigned long long integer = (unsigned long long)value;
+			unsigned long fraction = (unsigned long)((value - integer) * scale);
+			_printf_field(pf, sign, integer, 10, false, fraction, precision, width, left, zero);
+		} else if (*p == 'c') {
+			int pad = width - 1;
+			if (!left) _printf_repeat(pf, ' ', pad);
+			_printf_byte(pf, (uint8_t)va_arg(args, int));
+			if (left) _printf_repeat(pf, ' ', pad);
+		} else if (*p == 's') {
+			const char * text = va_arg(args, const char *);
+			if (text == NULL) text = "(null)";
+			int len = 0;
+			while (text[len] != '\0' && (precision < 0 || len < precision)) len++;
+			int pad = width - len;
+			if (!left) _printf_repeat(pf, ' ', pad);
+			for (int i = 0; i < len; i++) _printf_byte(pf, text[i]);
+			if (left) _printf_repeat(pf, ' ', pad);
+		} else if (*p == '%') {
+			_printf_byte(pf, '%');
+		} else {
+			// The type of the argument is not known, so the rest can not be formatted
+			ESP_LOGE(TAG, "unsupported conversion %%%c", *p);
+			break;
+		}
+	}
+	if (pf->utf8Len > 0) _printf_code(pf, 0xFFFD);
+	return pf->count;
+}
+
+// Print formatted text to internal buffer at the cursor. Not show it.
+// Characters are drawn while formatting, so no buffer is needed for the text.
+// Supported conversions are %d %i %u %o %x %X %p %c %s %f %% with flags - 0 + and space, width, precision and l/ll.
+// %f is for values less than 1e19 with up to 9 decimals. %e and %g are drawn as %f.
+// Formatting stops at any other conversion.
+// Returns the number of bytes formatted.
+int ssd1306_vprintf(SSD1306_t * dev, const ssd1306_font_t * font, bool invert, const char * format, va_list args)
+{
+	printf_t pf;
+	memset(&pf, 0, sizeof(pf));
+	pf.dev = dev;
+	pf.font = font;
+	pf.invert = invert;
+	return _printf_format(&pf, format, args);
+}
+
+int ssd1306_printf(SSD1306_t * dev, const ssd1306_font_t * font, bool invert, const char * format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	int count = ssd1306_vprintf(dev, font, invert, format, args);
+	va_end(args);
+	return count;
+}
+
+// Move the cursor of ssd1306_printf. A new line in the text goes back to xpos.
+void ssd1306_set_cursor(SSD1306_t * dev, int xpos, int ypos)
+{
+	dev->_cursorX = xpos;
+	dev->_cursorY = ypos;
+	dev->_cursorLeft = xpos;
+}
+
+// Show the changed lines of the console.
+// On 128x64 panels the page ring is in GDDRAM and scrolled by display start line,
+// so only changed pages are written. When flipped, page 0 is at the bottom of GDDRAM.
+// 128x32 panels show 32 of the 64 GDDRAM rows, so the start line can't turn a ring of 4 pages.
+// There each scroll writes the pages in the order of the ring.
+// Like ssd1306_show_dirty, each page is held while it is sent, and a page held by another task stays dirty.
+static void _terminal_flush(ssd1306_terminal_t * term)
+{
+	SSD1306_t * dev = term->_dev;
+	bool ring = (dev->_height == 64);
+	for (int line = 0; line < dev->_pages; line++) {
+		int page = (term->_top + line) % dev->_pages;
+		PAGE_t * _page = &dev->_page[page];
+		if (!_ssd1306_lock_flush(dev, page)) continue;
+		int start = _page->_dirtyStart;
+		int end = _page->_dirtyEnd;
+		if (term->_scrolled && !ring) {
+			start = 0;
+			end = dev->_width - 1;
+		}
+		_page->_dirtyStart = dev->_width;
+		_page->_dirtyEnd = -1;
+		if (start <= end) {
+			int dest = ring ? page : line;
+			if (dev->_address == SPIAddress) {
+				spi_display_image(dev, dest, start, &_page->_segs[start], end - start + 1);
+			} else {
+				i2c_display_image(dev, dest, start, &_page->_segs[start], end - start + 1);
+			}
+		}
+		ssd1306_unlock_region(dev, page, page);
+	}
+	if (term->_scrolled && ring) {
+		int line = term->_top * 8;
+		if (dev->_flip) line = (dev->_height - line) % dev->_height;
+		ssd1306_display_start_line(dev, line);
+	}
+	term->_scrolled = false;
+}
+
+// Move the cursor to the next line. On the last line the ring turns by one page
+// and the page of the old top line is cleared for the new line.
+static void _terminal_line_feed(ssd1306_terminal_t * term)
+{
+	SSD1306_t * dev = term->_dev;
+	term->_col = 0;
+	term->_prev = 0;
+	if (term->_row < dev->_pages - 1) {
+		term->_row++;
+		return;
+	}
+	int page = term->_top;
+	term->_top = (term->_top + 1) % dev->_pages;
+	term->_scrolled = true;
+	memset(dev->_page[page]._segs, term->_invert ? 0xFF : 0x00, dev->_width);
+	ssd1306_mark_dirty(dev, page, 0, dev->_width - 1);
+}
+
+// Width of a tab stop. 4 characters of '0'.
+static int _terminal_tab(ssd1306_terminal_t * term)
+{
+	if (term->_font == NULL) return 4 * 8;
+	const ssd1306_glyph_t * glyph = _font_glyph_or_default(term->_font, '0');
+	return 4 * ((glyph != NULL) ? glyph->advance : 8);
+}
+
+static void _terminal_code(ssd1306_terminal_t * term, uint32_t code)
+{
+	SSD1306_t * dev = term->_dev;
+	const ssd1306_font_t * font = term->_font;
+	if (code == '\n') {
+		_terminal_line_feed(term);
+		return;
+	}
+	if (code == '\r') {
+		term->_col = 0;
+		term->_prev = 0;
+		return;
+	}
+
+	int ypos = ((term->_top + term->_row) % dev->_pages) * 8;
+	int height = (font == NULL) ? 8 : font->height;
+	if (code == '\t') {
+		int tab = _terminal_tab(term);
+		int next = (term->_col / tab + 1) * tab;
+		if (next > dev->_width) next = dev->_width;
+		ssd1306_fill_rect(dev, term->_col, ypos, next - term->_col, height, !term->_invert);
+		term->_col = next;
+		term->_prev = 0;
+		return;
+	}
+
+	const uint8_t * images;
+	int width, left, advance;
+	if (font == NULL) {
+		images = _font8x8_glyph((char)code);
+		width = advance = 8;
+		left = 0;
+	} else {
+		const ssd1306_glyph_t * glyph = _font_glyph_or_default(font, code);
+		if (glyph == NULL) return;
+		images = &font->bitmap[glyph->offset];
+		width = glyph->width;
+		left = glyph->left;
+		advance = glyph->advance;
+		if (term->_prev != 0) term->_col = term->_col + _font_kerning(font, term->_prev, code);
+	}
+	// Auto wrap
+	if (term->_col + advance > dev->_width && term->_col > 0) {
+		_terminal_line_feed(term);
+		ypos = ((term->_top + term->_row) % dev->_pages) * 8;
+	}
+	ssd1306_fill_rect(dev, term->_col, ypos, left, height, !term->_invert);
+	ssd1306_fill_rect(dev, term->_col + left + width, ypos, advance - left - width, height, !term->_invert);
+	if (width != 0) {
+		ssd1306_blit(dev, term->_col + left, ypos, images, width, height, term->_invert, DRAW_COPY);
+	}
+	term->_col = term->_col + advance;
+	term->_prev = code;
+}
+
+// Start a console on the whole panel. The panel is cleared.
+// font NULL means 8x8 font. Fonts higher than 8 rows are not supported, because each line is one page.
+void ssd1306_terminal_init(SSD1306_t * dev, ssd1306_terminal_t * term, const ssd1306_font_t * font, bool invert)
+{
+	if (font != NULL && font->height > 8) {
+		ESP_LOGE(TAG, "terminal font is higher than 8 rows. 8x8 font is used");
+		font = NULL;
+	}
+	memset(term, 0, sizeof(ssd1306_terminal_t));
+	term->_dev = dev;
+	term->_font = font;
+	term->_invert = invert;
+	ssd1306_terminal_clear(term);
+}
+
+// Clear the console and move the cursor to the top left.
+// The ring goes back to page 0 at the top, so the display start line is reset.
+void ssd1306_terminal_clear(ssd1306_terminal_t * term)
+{
+	SSD1306_t * dev = term->_dev;
+	term->_top = 0;
+	term->_row = 0;
+	term->_col = 0;
+	term->_prev = 0;
+	term->_scrolled = false;
+	for (int page = 0; page < dev->_pages; page++) {
+		memset(dev->_page[page]._segs, term->_invert ? 0xFF : 0x00, dev->_width);
+	}
+	ssd1306_show_buffer(dev);
+	ssd1306_display_start_line(dev, 0);
+}
+
+// Stop the console and leave its text on the panel.
+// Pages of internal buffer are turned back to the order of the lines and the display start line is reset,
+// so the other functions draw at the right place again.
+void ssd1306_terminal_deinit(ssd1306_terminal_t * term)
+{
+	SSD1306_t * dev = term->_dev;
+	uint8_t segs[128];
+	// Turn the ring left by _top pages, one page at a time.
+	for (int turn = 0; turn < term->_top; turn++) {
+		memcpy(segs, dev->_page[0]._segs, dev->_width);
+		for (int page = 0; page < dev->_pages - 1; page++) {
+			memcpy(dev->_page[page]._segs, dev->_page[page + 1]._segs, dev->_width);
+		}
+		memcpy(dev->_page[dev->_pages - 1]._segs, segs, dev->_width);
+	}
+	term->_top = 0;
+	term->_scrolled = false;
+	ssd1306_show_buffer(dev);
+	ssd1306_display_start_line(dev, 0);
+}
+
+// Write text to the console and show it.
+// \n goes to the next line, \r to the start of the line and \t to the next tab stop.
+// Long lines wrap. Only changed segments of the console are written.
+void ssd1306_terminal_write(ssd1306_terminal_t * term, char * text, int text_len)
+{
+	printf_t pf;
+	memset(&pf, 0, sizeof(pf));
+	pf.dev = term->_dev;
+	pf.term = term;
+	pf.font = term->_font;
+	for (int i = 0; i < text_len; i++) _printf_byte(&pf, text[i]);
+	if (pf.utf8Len > 0) _printf_code(&pf, 0xFFFD);
+	_terminal_flush(term);
+}
+
+// Print formatted text to the console and show it.
+int ssd1306_terminal_printf(ssd1306_terminal_t * term, const char * format, ...)
+{
+	printf_t pf;
+	memset(&pf, 0, sizeof(pf));
+	pf.dev = term->_dev;
+	pf.term = term;
+	pf.font = term->_font;
+	va_list args;
+	va_start(args, format);
+	int count = _printf_format(&pf, format, args);
+	va_end(args);
+	_terminal_flush(term);
+	return count;
+}
+
+// Go to the next cell of the ticker strip. The strip is the text followed by the gap, repeated.
+static void _ticker_cell(ssd1306_ticker_t * ticker)
+{
+	const ssd1306_font_t * font = ticker->_font;
+	ticker->_column = 0;
+	if (ticker->_pos >= ticker->_textLen && !ticker->_inGap) {
+		ticker->_inGap = true;
+		ticker->_advance = ticker->_gap;
+		if (ticker->_textLen == 0 && ticker->_advance < 1) ticker->_advance = 1;
+		return;
+	}
+	if (ticker->_inGap) {
+		ticker->_inGap = false;
+		ticker->_pos = 0;
+		if (ticker->_next != NULL) {
+			ticker->_text = ticker->_next;
+			ticker->_textLen = ticker->_nextLen;
+			ticker->_next = NULL;
+		}
+		if (ticker->_textLen == 0) {
+			_ticker_cell(ticker);
+			return;
+		}
+	}
+	ticker->_code = _layout_next(font, ticker->_text, ticker->_textLen, &ticker->_pos);
+	ticker->_advance = _layout_advance(font, 0, ticker->_code);
+	if (font != NULL && ticker->_pos < ticker->_textLen) {
+		int pos = ticker->_pos;
+		uint32_t next = _layout_next(font, ticker->_text, ticker->_textLen, &pos);
+		ticker->_advance = ticker->_advance + _font_kerning(font, ticker->_code, next);
+	}
+	// Every cell moves the strip, so the ticker never stalls
+	if (ticker->_advance < 1) ticker->_advance = 1;
+}
+
+// Set the next column of the strip to segment seg of the band in internal buffer.
+static void _ticker_column(ssd1306_ticker_t * ticker, int seg)
+{
+	SSD1306_t * dev = ticker->_dev;
+	const ssd1306_font_t * font = ticker->_font;
+	while (ticker->_column >= ticker->_advance) _ticker_cell(ticker);
+	int column = ticker->_column++;
+	for (int page = 0; page < ticker->_pages; page++) {
+		uint8_t wk = 0;
+		if (!ticker->_inGap) {
+			if (font == NULL) {
+				if (column < 8) wk = _font8x8_glyph(ticker->_code)[column];
+			} else {
+				const ssd1306_glyph_t * glyph = _font_glyph_or_default(font, ticker->_code);
+				int xx = column - ((glyph != NULL) ? glyph->left : 0);
+				if (glyph != NULL && xx >= 0 && xx < glyph->width) {
+					wk = font->bitmap[glyph->offset + page * glyph->width + xx];
+				}
+			}
+		}
+		if (ticker->_invert) wk = ~wk;
+		if (dev->_flip) wk = ssd1306_rotate_byte(wk);
+		dev->_page[ticker->_page + page]._segs[seg] = wk;
+	}
+}
+
+// Start a ticker in segments start to end of the pages from page. The window is cleared.
+// font NULL means 8x8 font. text is kept by the ticker and enters from the right edge.
+// gap is the blank columns between the end of text and its next start.
+// hardware uses the one column content scroll of the controller, so a one column tick sends
+// one column of the band. Not all controllers have it.
+void ssd1306_ticker_init(SSD1306_t * dev, ssd1306_ticker_t * ticker, const ssd1306_font_t * font, int page, int start, int end, char * text, int text_len, int gap, bool invert, bool hardware)
+{
+	int height = (font == NULL) ? 8 : font->height;
+	memset(ticker, 0, sizeof(ssd1306_ticker_t));
+	ticker->_dev = dev;
+	// A ticker that is not started does nothing on tick
+	if (page < 0 || page >= dev->_pages) {
+		ESP_LOGE(TAG, "ticker page %d is not on the panel", page);
+		return;
+	}
+	if (start < 0) start = 0;
+	if (end >= dev->_width) end = dev->_width - 1;
+	if (start > end) {
+		ESP_LOGE(TAG, "ticker has no column on the panel from %d to %d", start, end);
+		return;
+	}
+	ticker->_font = font;
+	ticker->_text = text;
+	ticker->_textLen = text_len;
+	ticker->_page = page;
+	ticker->_pages = (height + 7) / 8;
+	if (ticker->_page + ticker->_pages > dev->_pages) {
+		ESP_LOGW(TAG, "ticker does not fit from page %d", page);
+		ticker->_pages = dev->_pages - ticker->_page;
+	}
+	ticker->_start = start;
+	ticker->_end = end;
+	ticker->_gap = gap;
+	ticker->_invert = invert;
+	ticker->_hardware = hardware;
+	// Start in the gap, so the text enters from the right edge
+	ticker->_inGap = true;
+	ticker->_pos = text_len;
+
+	int endPage = ticker->_page + ticker->_pages - 1;
+	for (int _page = ticker->_page; _page <= endPage; _page++) {
+		memset(&dev->_page[_page]._segs[ticker->_start], invert ? 0xFF : 0x00, ticker->_end - ticker->_start + 1);
+	}
+	ssd1306_show_window(dev, ticker->_page, endPage, ticker->_start, ticker->_end);
+}
+
+// Show text after the current text has gone through.
+void ssd1306_ticker_set_text(ssd1306_ticker_t * ticker, char * text, int text_len)
+{
+	ticker->_next = text;
+	ticker->_nextLen = text_len;
+}
+
+// Move the ticker left by columns and show it.
+// Only the band is sent. The new columns are rendered as they enter.
+// With hardware, a one column tick is a content scroll and one column of transfer.
+// The controller needs 2 frames between content scrolls, so do not tick faster than that.
+void ssd1306_ticker_tick(ssd1306_ticker_t * ticker, int columns)
+{
+	SSD1306_t * dev = ticker->_dev;
+	int endPage = ticker->_page + ticker->_pages - 1;
+	int width = ticker->_end - ticker->_start + 1;
+	if (ticker->_pages <= 0 || width <= 0) return;
+	if (columns < 1) columns = 1;
+	if (columns > width) columns = width;
+
+	if (ticker->_hardware && columns == 1) {
+		ssd1306_content_scroll(dev, SCROLL_LEFT, ticker->_page, endPage, ticker->_start, ticker->_end);
+		_ticker_column(ticker, ticker->_end);
+		ssd1306_show_window(dev, ticker->_page, endPage, ticker->_end, ticker->_end);
+		return;
+	}
+
+	for (int page = ticker->_page; page <= endPage; page++) {
+		uint8_t * segs = dev->_page[page]._segs;
+		memmove(&segs[ticker->_start], &segs[ticker->_start + columns], width - columns);
+	}
+	for (int seg = ticker->_end - columns + 1; seg <= ticker->_end; seg++) {
+		_ticker_column(ticker, seg);
+	}
+	ssd1306_show_window(dev, ticker->_page, endPage, ticker->_start, ticker->_end);
+}
@@ -0,0 +1,234 @@
+#!/usr/bin/env python3
+"""Convert BDF font to proportional font header for esp-idf-ssd1306.
+
+The output is a ssd1306_font_t with glyphs already transposed to page format.
+Every glyph is (height + 7) / 8 pages of width bytes, top row is bit 0.
+Empty columns on both sides of each glyph are removed and kept as left bearing.
+
+TrueType fonts can be rasterized to BDF first, for example:
+    otf2bdf -p 16 -r 72 -o myfont16.bdf myfont.ttf
+
+Usage:
+    python3 bdf2font.py font.bdf --name font5x7 --proportional --spacing 1 > font5x7.h
+    python3 bdf2font.py font.bdf --name font12x16 --range 0x20-0x7E
+    python3 bdf2font.py font.bdf --name font5x7 --kerning kerning.txt
+
+    python3 bdf2font.py unifont.bdf --name font_menu --range 0x20-0x7E,0x410-0x44F --chars "äöüßé"
+
+Characters that are not contiguous make a sparse font. Only the glyphs of the
+selected characters are stored and they are looked up by a sorted range index.
+Code points of the range missing from the BDF also split the ranges, so they are
+left out of the font and drawn as '?' like any other missing character.
+
+font5x7.h is made from tools/font5x7.bdf with:
+    python3 tools/bdf2font.py tools/font5x7.bdf --name font5x7 --proportional --spacing 1 \
+        --kerning tools/font5x7_kerning.txt > components/ssd1306/font5x7.h
+
+kerning.txt has one pair per line: first second adjust, e.g. "A V -1".
+"""
+
+import argparse
+import sys
+
+
+def parse_bdf(path):
+    font = {'glyphs': {}}
+    with open(path, encoding='latin-1') as f:
+        lines = iter(f.read().splitlines())
+    glyph = None
+    for line in lines:
+        words = line.split()
+        if not words:
+            continue
+        key = words[0]
+        if key == 'FONTBOUNDINGBOX':
+            font['bbx'] = [int(v) for v in words[1:5]]
+        elif key == 'FONT_ASCENT':
+            font['ascent'] = int(words[1])
+        elif key == 'FONT_DESCENT':
+            font['descent'] = int(words[1])
+        elif key == 'STARTCHAR':
+            glyph = {'name': ' '.join(words[1:])}
+        elif key == 'ENCODING':
+            glyph['code'] = int(words[1])
+        elif key == 'DWIDTH':
+            glyph['dwidth'] = int(words[1])
+        elif key == 'BBX':
+            glyph['bbx'] = [int(v) for v in words[1:5]]
+        elif key == 'BITMAP':
+            rows = []
+            for row in lines:
+                if row.strip() == 'ENDCHAR':
+                    break
+                rows.append(row.strip())
+            glyph['rows'] = rows
+            if glyph['code'] >= 0:
+                font['glyphs'][glyph['code']] = glyph
+            glyph = None
+    if 'ascent' not in font:
+        font['ascent'] = font['bbx'][1] + font['bbx'][3]
+    if 'descent' not in font:
+        font['descent'] = -font['bbx'][3]
+    return font
+
+
+def glyph_pixels(font, glyph):
+    """Return set of (x, y) pixels. y is from the top of the font."""
+    width, height, xoff, yoff = glyph['bbx']
+    top = font['ascent'] - (yoff + height)
+    pixels = set()
+    for row, hexa in enumerate(glyph['rows']):
+        bits = int(hexa, 16) if hexa else 0
+        nbits = len(hexa) * 4
+        for col in range(width):
+            if bits & (1 << (nbits - 1 - col)):
+                pixels.add((xoff + col, top + row))
+    return pixels
+
+
+def parse_range(text):
+    codes = []
+    for part in text.split(','):
+        lo, _, hi = part.partition('-')
+        lo = int(lo, 0)
+        hi = int(hi, 0) if hi else lo
+        codes.extend(range(lo, hi + 1))
+    return codes
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('bdf')
+    parser.add_argument('--name', required=True, help='C name of the font')
+    parser.add_argument('--range', default='0x20-0x7E', help='code points, e.g. 0x20-0x7E,0x410-0x44F')
+    parser.add_argument('--chars', default='', help='characters added to the range, e.g. "äöü"')
+    parser.add_argument('--proportional', action='store_true', help='advance is the width of each glyph plus spacing')
+    parser.add_argument('--spacing', type=int, default=0, help='columns added to every advance')
+    parser.add_argument('--kerning', help='file of kerning pairs')
+    parser.add_argument('--source', default=None, help='comment of the original font')
+    args = parser.parse_args()
+
+    font = parse_bdf(args.bdf)
+    height = font['ascent'] + font['descent']
+    pages = (height + 7) // 8
+    codes = set(parse_range(args.range)) | {ord(c) for c in args.chars}
+    codes = sorted(c for c in codes if c in font['glyphs'] and c <= 0xFFFF)
+    if not codes:
+        sys.exit('no characters of the range are in the font')
+    first = codes[0]
+    last = codes[-1]
+
+    # Runs of contiguous code points. codes has only characters of the font,
+    # so a hole ends a run and the font becomes sparse.
+    ranges = []
+    for code in codes:
+        if ranges and ranges[-1][1] == code - 1:
+            ranges[-1][1] = code
+        else:
+            ranges.append([code, code, len([c for c in codes if c < code])])
+    sparse = len(ranges) > 1
+
+    bitmap = []
+    glyphs = []
+    for code in codes:
+        glyph = font['glyphs'][code]
+        pixels = {(x, y) for (x, y) in glyph_pixels(font, glyph) if 0 <= y < height}
+        advance = glyph.get('dwidth', glyph['bbx'][0]) + args.spacing
+        if not pixels:
+            glyphs.append((len(bitmap), 0, advance, 0, code))
+            continue
+        left = min(x for x, _ in pixels)
+        right = max(x for x, _ in pixels)
+        width = right - left + 1
+        if args.proportional:
+            advance = width + args.spacing
+            left_bearing = 0
+        else:
+            left_bearing = left
+        offset = len(bitmap)
+        for page in range(pages):
+            for x in range(left, right + 1):
+                byte = 0
+                for bit in range(8):
+                    if (x, page * 8 + bit) in pixels:
+                        byte |= 1 << bit
+                bitmap.append(byte)
+        glyphs.append((offset, width, advance, left_bearing, code))
+
+    if len(bitmap) > 0xFFFF:
+        sys.exit('bitmap is larger than 64KB, use less characters')
+
+    kerning = []
+    if args.kerning:
+        with open(args.kerning, encoding='utf-8') as f:
+            for line in f:
+                words = line.split()
+                if len(words) != 3 or words[0].startswith('#'):
+                    continue
+                pair = [ord(w) if len(w) == 1 else int(w, 0) for w in words[:2]]
+                kerning.append((pair[0], pair[1], int(words[2])))
+        kerning.sort()
+
+    name = args.name
+    guard = 'MAIN_%s_H_' % name.upper()
+    out = []
+    out.append('/*')
+    out.append(' * %s.h' % name)
+    out.append(' *')
+    out.append(' * Generated by tools/bdf2font.py from %s' % (args.source or args.bdf.split('/')[-1]))
+    out.append(' * Regenerate with: python3 tools/bdf2font.py %s' % ' '.join(sys.argv[1:]))
+    out.append(' * height=%d ascent=%d characters=%d ranges=%d bitmap=%d bytes' % (height, font['ascent'], len(glyphs), len(ranges), len(bitmap)))
+    out.append(' */')
+    out.append('')
+    out.append('#ifndef %s' % guard)
+    out.append('#define %s' % guard)
+    out.append('')
+    out.append('#include "ssd1306.h"')
+    out.append('')
+    out.append('static const uint8_t %s_bitmap[%d] = {' % (name, max(len(bitmap), 1)))
+    for offset, width, advance, left, code in glyphs:
+        if width == 0:
+            continue
+        data = bitmap[offset:offset + width * pages]
+        comment = chr(code) if 0x20 < code and code != 0x5C and code != 0x7F else ''
+        out.append('    %s   // U+%04X %s' % (' '.join('0x%02X,' % b for b in data), code, comment))
+    if not bitmap:
+        out.append('    0x00')
+    out.append('};')
+    out.append('')
+    out.append('static const ssd1306_glyph_t %s_glyphs[%d] = {' % (name, len(glyphs)))
+    for offset, width, advance, left, code in glyphs:
+        out.append('    { %5d, %2d, %2d, %2d },   // U+%04X' % (offset, width, advance, left, code))
+    out.append('};')
+    out.append('')
+    if kerning:
+        out.append('static const ssd1306_kern_t %s_kerning[%d] = {' % (name, len(kerning)))
+        for a, b, adjust in kerning:
+            out.append('    { 0x%04X, 0x%04X, %d },' % (a, b, adjust))
+        out.append('};')
+        out.append('')
+    if sparse:
+        out.append('static const ssd1306_range_t %s_ranges[%d] = {' % (name, len(ranges)))
+        for lo, hi, index in ranges:
+            out.append('    { 0x%04X, 0x%04X, %d },' % (lo, hi, index))
+        out.append('};')
+        out.append('')
+    out.append('static const ssd1306_font_t %s = {' % name)
+    out.append('    .bitmap = %s_bitmap,' % name)
+    out.append('    .glyphs = %s_glyphs,' % name)
+    out.append('    .kerning = %s,' % ('%s_kerning' % name if kerning else 'NULL'))
+    out.append('    .kerningLen = %d,' % len(kerning))
+    out.append('    .ranges = %s,' % ('%s_ranges' % name if sparse else 'NULL'))
+    out.append('    .rangeLen = %d,' % (len(ranges) if sparse else 0))
+    out.append('    .first = 0x%02X,' % first)
+    out.append('    .last = 0x%02X,' % last)
+    out.append('    .height = %d,' % height)
+    out.append('    .ascent = %d,' % font['ascent'])
+    out.append('};')
+    out.append('')
+    out.append('#endif /* %s */' % guard)
+    print('\n'.join(out))
+
+
+if __name__ == '__main__':
+    main()